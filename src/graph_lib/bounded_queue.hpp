@@ -0,0 +1,123 @@
+#pragma once
+
+/*
+    Blocking queue with the fixed capacity, used to connect the stages of the pipeline.
+    Producer blocks while the queue is full, so the fast stage can't run away from the slow one
+    and the memory stays bounded by the capacity.
+    Following functionalities are provided:
+
+    push(item)               Wait for the free place and insert the item, returns false if the queue is closed
+    pop()                    Wait for the item and remove it, returns nothing once the queue is closed and empty
+    close()                  No more items will be pushed, wakes up everyone that waits
+    push_waited()            Return the total time that push spent blocked on the full queue
+    pop_waited()             Return the total time that pop spent blocked on the empty queue
+*/
+
+#include "graph_lib_base.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <assert.h>
+
+template <typename T>
+class graph_lib::bounded_queue
+{
+public:
+
+    using clock_type    = std::chrono::steady_clock;
+    using duration_type = clock_type::duration;
+
+private:
+
+    // member variables
+
+    std::mutex              _mutex;
+    std::condition_variable _not_full;
+    std::condition_variable _not_empty;
+    std::deque<T>           _items;
+    std::size_t             _capacity;
+    bool                    _closed;
+    duration_type           _push_waited;
+    duration_type           _pop_waited;
+
+public:
+
+    explicit bounded_queue(std::size_t capacity)
+        : _mutex{}, _not_full{}, _not_empty{}, _items{}, _capacity{capacity}, _closed{false},
+          _push_waited{}, _pop_waited{}
+    {
+        assert(capacity > 0);
+    }
+
+    bounded_queue(bounded_queue const &) = delete;
+    bounded_queue & operator=(bounded_queue const &) = delete;
+
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+
+        auto const start = clock_type::now();
+        _not_full.wait(lock, [&]{ return _closed || _items.size() < _capacity; });
+        _push_waited += clock_type::now() - start;
+
+        if (_closed)
+        {
+            return false;
+        }
+
+        _items.emplace_back(std::move(item));
+        lock.unlock();
+        _not_empty.notify_one();
+
+        return true;
+    }
+
+    [[nodiscard]] auto pop()
+        -> std::optional<T>
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+
+        auto const start = clock_type::now();
+        _not_empty.wait(lock, [&]{ return _closed || !_items.empty(); });
+        _pop_waited += clock_type::now() - start;
+
+        if (_items.empty())
+        {
+            return std::nullopt;
+        }
+
+        std::optional<T> item{std::move(_items.front())};
+        _items.pop_front();
+        lock.unlock();
+        _not_full.notify_one();
+
+        return item;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _closed = true;
+        }
+        _not_full.notify_all();
+        _not_empty.notify_all();
+    }
+
+    // time that the producers spent waiting for the free place
+    [[nodiscard]] auto push_waited()
+        -> duration_type
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        return _push_waited;
+    }
+
+    // time that the consumers spent waiting for the item
+    [[nodiscard]] auto pop_waited()
+        -> duration_type
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        return _pop_waited;
+    }
+};
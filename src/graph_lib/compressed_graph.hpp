@@ -0,0 +1,432 @@
+#pragma once
+
+/*
+    Read-only representation of the graph for very large meshes.
+    Every vertex gets an id, its position in the graph it was built from, and the neighbors of
+    every vertex are stored as the sorted list of ids. Lists are encoded as the degree, the first id
+    and the gaps between the consecutive ids, every number as a varint (7 bits per byte, highest bit
+    set on all bytes but the last one). For well ordered meshes most of the gaps fit into one byte.
+    Lists are decoded on the fly, nothing is ever decompressed as a whole.
+    Following functionalities are provided:
+
+    num_vertices()           Return the number of vertices in G
+    num_edges()              Return the number of edges in G
+    vertices()               Return the vector of the vertices of G, ordered by id
+
+    degree(v)                Return the degree of v
+    adjacent_vertices(v)     Return a range of the vertices adjacent to v, ordered by id
+    are_adjacent(v,w)        Return whether vertices v and w are adjacent
+    memory_usage()           Return the number of bytes allocated by G
+
+    NOTE: vertices are looked up by the binary search, so node_type has to provide operator<
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "graph_lib_detail.hpp"
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+namespace graph_lib::detail
+{
+    // appends value to the buffer as a varint
+    inline void encode_varint(std::vector<std::uint8_t> & buffer, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            buffer.emplace_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        buffer.emplace_back(static_cast<std::uint8_t>(value));
+    }
+
+    // reads one varint and moves the pointer behind it
+    [[nodiscard]] inline auto decode_varint(std::uint8_t const * & data) noexcept
+        -> std::uint64_t
+    {
+        std::uint64_t value{*data & 0x7Fu};
+        unsigned shift{7};
+        while ((*data++ & 0x80) != 0)
+        {
+            value |= std::uint64_t{*data & 0x7Fu} << shift;
+            shift += 7;
+        }
+        return value;
+    }
+}
+
+template <typename V, bool undirected>
+class graph_lib::compressed_graph
+{
+public:
+
+    // aliases for convenience
+    using node_type          = typename graph<V,undirected>::node_type;
+    using id_type            = std::uint32_t;
+    using vertices_size_type = std::size_t;
+    using edges_size_type    = std::size_t;
+
+    // forward iterator that decodes one neighbor list, yields the ids of the neighbors
+    class id_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = id_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = id_type const *;
+        using reference         = id_type const &;
+
+        id_iterator() noexcept = default;
+
+        id_iterator(std::uint8_t const * data, edges_size_type remaining) noexcept
+            : _data{data}, _remaining{remaining}, _current{}
+        {
+            if (_remaining != 0)
+            {
+                _current = static_cast<id_type>(detail::decode_varint(_data));
+            }
+        }
+
+        [[nodiscard]] auto operator*() const noexcept
+            -> reference
+        {
+            return _current;
+        }
+
+        auto operator++() noexcept
+            -> id_iterator &
+        {
+            if (--_remaining != 0)
+            {
+                _current = static_cast<id_type>(_current + detail::decode_varint(_data));
+            }
+            return *this;
+        }
+
+        auto operator++(int) noexcept
+            -> id_iterator
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        // all of the iterators of the same list are equal once they reach the end
+        [[nodiscard]] friend bool operator==(id_iterator const & first, id_iterator const & second) noexcept
+        {
+            return first._remaining == second._remaining;
+        }
+
+        [[nodiscard]] friend bool operator!=(id_iterator const & first, id_iterator const & second) noexcept
+        {
+            return !(first == second);
+        }
+
+    private:
+        std::uint8_t const * _data{};
+        edges_size_type      _remaining{};
+        id_type              _current{};
+    };
+
+    // forward iterator that decodes one neighbor list, yields the neighbors themself
+    class neighbor_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = node_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = node_type const *;
+        using reference         = node_type const &;
+
+        neighbor_iterator() noexcept = default;
+
+        neighbor_iterator(id_iterator it, node_type const * vertices) noexcept
+            : _it{it}, _vertices{vertices}
+        {
+        }
+
+        [[nodiscard]] auto operator*() const noexcept
+            -> reference
+        {
+            return _vertices[*_it];
+        }
+
+        [[nodiscard]] auto operator->() const noexcept
+            -> pointer
+        {
+            return _vertices + *_it;
+        }
+
+        auto operator++() noexcept
+            -> neighbor_iterator &
+        {
+            ++_it;
+            return *this;
+        }
+
+        auto operator++(int) noexcept
+            -> neighbor_iterator
+        {
+            auto copy = *this;
+            ++_it;
+            return copy;
+        }
+
+        [[nodiscard]] friend bool operator==(neighbor_iterator const & first, neighbor_iterator const & second) noexcept
+        {
+            return first._it == second._it;
+        }
+
+        [[nodiscard]] friend bool operator!=(neighbor_iterator const & first, neighbor_iterator const & second) noexcept
+        {
+            return !(first == second);
+        }
+
+    private:
+        id_iterator       _it{};
+        node_type const * _vertices{};
+    };
+
+    // range over one decoded neighbor list
+    template <typename It>
+    class range
+    {
+    public:
+        range(It first, It last, edges_size_type size) noexcept
+            : _first{first}, _last{last}, _size{size}
+        {
+        }
+
+        [[nodiscard]] auto begin() const noexcept -> It { return _first; }
+        [[nodiscard]] auto end() const noexcept -> It { return _last; }
+        [[nodiscard]] auto size() const noexcept -> edges_size_type { return _size; }
+        [[nodiscard]] auto empty() const noexcept -> bool { return _size == 0; }
+
+    private:
+        It              _first;
+        It              _last;
+        edges_size_type _size;
+    };
+
+private:
+
+    // member variables
+
+    std::vector<node_type>     _vertices;
+    std::vector<id_type>       _ids_by_vertex;
+    std::vector<std::uint64_t> _offsets;
+    std::vector<std::uint8_t>  _data;
+    edges_size_type            _number_of_edges;
+
+public:
+
+    // compresses the graph, ids are the positions of the vertices in g
+    // asserts that every neighbor is a vertex of g
+    explicit compressed_graph(graph<V,undirected> const & g)
+        : _vertices{}, _ids_by_vertex{}, _offsets{}, _data{}, _number_of_edges{g.num_edges()}
+    {
+        assert(g.num_vertices() <= std::numeric_limits<id_type>::max());
+
+        auto const adjacency = detail::make_compact_adjacency(g);
+
+        _vertices.reserve(g.num_vertices());
+        for (auto it = g.cbegin(); it != g.cend(); ++it)
+        {
+            _vertices.emplace_back(it->first);
+        }
+
+        _ids_by_vertex.resize(std::size(_vertices));
+        std::iota(std::begin(_ids_by_vertex), std::end(_ids_by_vertex), id_type{});
+        std::sort(std::begin(_ids_by_vertex), std::end(_ids_by_vertex),
+                  [this](id_type first, id_type second){ return _vertices[first] < _vertices[second]; });
+
+        // one byte per neighbor and two for the degree is a good first guess
+        _offsets.reserve(std::size(_vertices) + 1);
+        _data.reserve(std::size(adjacency.targets) + 2 * std::size(_vertices));
+
+        std::vector<std::size_t> neighbors{};
+        for (std::size_t slot = 0; slot < adjacency.num_vertices(); ++slot)
+        {
+            _offsets.emplace_back(std::size(_data));
+
+            neighbors.assign(std::cbegin(adjacency.targets) + static_cast<std::ptrdiff_t>(adjacency.offsets[slot]),
+                             std::cbegin(adjacency.targets) + static_cast<std::ptrdiff_t>(adjacency.offsets[slot + 1]));
+            std::sort(std::begin(neighbors), std::end(neighbors));
+
+            detail::encode_varint(_data, std::size(neighbors));
+            std::size_t previous{};
+            for (auto const neighbor : neighbors)
+            {
+                detail::encode_varint(_data, neighbor - previous);
+                previous = neighbor;
+            }
+        }
+        _offsets.emplace_back(std::size(_data));
+
+        _data.shrink_to_fit();
+    }
+
+    // returns the number of vertices in G
+    [[nodiscard]] auto num_vertices() const noexcept
+        -> vertices_size_type
+    {
+        return std::size(_vertices);
+    }
+
+    // returns the number of edges in G
+    [[nodiscard]] auto num_edges() const noexcept
+        -> edges_size_type
+    {
+        return _number_of_edges;
+    }
+
+    // returns all of the vertices, the position of the vertex is its id
+    [[nodiscard]] auto vertices() const noexcept
+        -> std::vector<node_type> const &
+    {
+        return _vertices;
+    }
+
+    // returns the id of the vertex
+    // asserts whether the graph contains that vertex
+    [[nodiscard]] auto id(V const & vertex) const
+        -> id_type
+    {
+        node_type const key{vertex};
+        auto const it = std::lower_bound(std::cbegin(_ids_by_vertex), std::cend(_ids_by_vertex), key,
+                                         [this](id_type first, node_type const & second){ return _vertices[first] < second; });
+        assert(it != std::cend(_ids_by_vertex) && _vertices[*it] == key);
+
+        return *it;
+    }
+
+    // returns the degree of the vertex with the given id, only the header of the list is decoded
+    [[nodiscard]] auto degree_of_id(id_type id) const noexcept
+        -> edges_size_type
+    {
+        auto const * data = _data.data() + _offsets[id];
+        return edges_size_type{detail::decode_varint(data)};
+    }
+
+    // returns the degree of the vertex
+    // asserts whether the graph contains that vertex
+    [[nodiscard]] auto degree(V const & vertex) const
+        -> edges_size_type
+    {
+        return degree_of_id(id(vertex));
+    }
+
+    // returns the ids of the neighbors of the vertex with the given id, in ascending order
+    [[nodiscard]] auto adjacent_ids(id_type id) const noexcept
+        -> range<id_iterator>
+    {
+        auto const * data = _data.data() + _offsets[id];
+        auto const size = edges_size_type{detail::decode_varint(data)};
+
+        return range<id_iterator>{id_iterator{data, size}, id_iterator{}, size};
+    }
+
+    // returns the neighbors of the vertex, ordered by their ids
+    // asserts whether the graph contains that vertex
+    [[nodiscard]] auto adjacent_vertices(V const & vertex) const
+        -> range<neighbor_iterator>
+    {
+        auto const ids = adjacent_ids(id(vertex));
+
+        return range<neighbor_iterator>{neighbor_iterator{ids.begin(), _vertices.data()},
+                                        neighbor_iterator{ids.end(), _vertices.data()},
+                                        ids.size()};
+    }
+
+    // checks whether the two vertices are adjacent, decoding stops as soon as the list passes w
+    [[nodiscard]] bool are_adjacent(V const & node_a, V const & node_b) const
+    {
+        auto const target = id(node_b);
+
+        for (auto const neighbor : adjacent_ids(id(node_a)))
+        {
+            if (neighbor >= target)
+            {
+                return neighbor == target;
+            }
+        }
+        return false;
+    }
+
+    // returns the number of bytes allocated by the graph, without the heap memory owned by the vertices
+    [[nodiscard]] auto memory_usage() const noexcept
+        -> std::size_t
+    {
+        return _vertices.capacity()      * sizeof(node_type)
+             + _ids_by_vertex.capacity() * sizeof(id_type)
+             + _offsets.capacity()       * sizeof(std::uint64_t)
+             + _data.capacity()          * sizeof(std::uint8_t);
+    }
+};
+
+/*
+Triangle listing on the compressed graph
+
+for each vertex u in G.vertices() {
+    for each vertex v in G.adjacentVertices(u) with id(v) > id(u)
+    {
+        // both lists are sorted, so they are intersected by merging the two decoders
+        for each vertex w in G.adjacentVertices(u) intersected with G.adjacentVertices(v) with id(w) > id(v)
+            T.insertLast((u,v,w));
+    }
+}
+return T
+
+NOTE: unlike find_triangular_faces every triangle is listed exactly once, ordered by the ids
+*/
+template <typename V>
+auto graph_lib::find_triangles(compressed_graph<V, true> const & g)
+    -> typename std::vector<std::tuple<V,V,V>>
+{
+    using id_type = typename compressed_graph<V, true>::id_type;
+
+    std::vector<std::tuple<V,V,V>> ret_val{};
+    auto const & vertices = g.vertices();
+
+    for (id_type u = 0; u < g.num_vertices(); ++u)
+    {
+        auto const u_neighbors = g.adjacent_ids(u);
+
+        for (auto v_it = u_neighbors.begin(); v_it != u_neighbors.end(); ++v_it)
+        {
+            auto const v = *v_it;
+            if (v <= u)
+            {
+                continue;
+            }
+
+            auto first      = std::next(v_it);
+            auto const last = u_neighbors.end();
+            auto const v_neighbors = g.adjacent_ids(v);
+            auto second = v_neighbors.begin();
+
+            while (first != last && second != v_neighbors.end())
+            {
+                if (*second <= v || *second < *first)
+                {
+                    ++second;
+                }
+                else if (*first < *second)
+                {
+                    ++first;
+                }
+                else
+                {
+                    ret_val.emplace_back(std::tuple{vertices[u], vertices[v], vertices[*first]});
+                    ++first;
+                    ++second;
+                }
+            }
+        }
+    }
+
+    return ret_val;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+/*
+    Copy-on-write vector, used for the neighbor lists of the graph.
+    Copies of the cow_vector share the same block of elements, the block is copied only when
+    one of the copies asks for the mutable access while it is shared with some other copy.
+    Empty cow_vector doesn't allocate anything.
+    Following functionalities are provided:
+
+    size(), empty()          Return the number of elements, whether there are no elements
+    begin(), end()           Return the const iterators over the elements
+    at(i), operator[](i)     Return the element at the position i
+    get()                    Return the underlying std::vector
+    mutate()                 Return the underlying std::vector for modification, copies it if it is shared
+    shared()                 Return whether the block is shared with some other copy
+    block()                  Return the address of the shared block, nullptr when empty (used for prefetching)
+    capacity()               Return the number of elements the block can hold without the reallocation
+    shrink_to_fit()          Release the unused capacity, the empty block is released as a whole
+                             (blocks shared with other copies are left alone)
+*/
+
+#include "graph_lib_base.hpp"
+#include <memory>
+
+template <typename T>
+class graph_lib::cow_vector
+{
+public:
+
+    // aliases for convenience
+    using vector_type    = std::vector<T>;
+    using value_type     = typename vector_type::value_type;
+    using size_type      = typename vector_type::size_type;
+    using const_iterator = typename vector_type::const_iterator;
+
+private:
+
+    // member variables
+
+    std::shared_ptr<vector_type> _block;
+
+public:
+
+    cow_vector() noexcept = default;
+
+    cow_vector(vector_type && elements)
+        : _block{elements.empty() ? nullptr : std::make_shared<vector_type>(std::move(elements))}
+    {
+    }
+
+    cow_vector(vector_type const & elements)
+        : _block{elements.empty() ? nullptr : std::make_shared<vector_type>(elements)}
+    {
+    }
+
+    [[nodiscard]] auto get() const noexcept
+        -> vector_type const &
+    {
+        return _block ? *_block : empty_vector();
+    }
+
+    [[nodiscard]] operator vector_type const & () const noexcept
+    {
+        return get();
+    }
+
+    // returns the vector that is owned only by this copy, so it can be safely modified
+    [[nodiscard]] auto mutate()
+        -> vector_type &
+    {
+        if (!_block)
+        {
+            _block = std::make_shared<vector_type>();
+        }
+        else if (_block.use_count() > 1)
+        {
+            _block = std::make_shared<vector_type>(*_block);
+        }
+        return *_block;
+    }
+
+    [[nodiscard]] auto block() const noexcept
+        -> vector_type const *
+    {
+        return _block.get();
+    }
+
+    [[nodiscard]] bool shared() const noexcept
+    {
+        return _block && _block.use_count() > 1;
+    }
+
+    [[nodiscard]] auto size() const noexcept
+        -> size_type
+    {
+        return _block ? _block->size() : 0;
+    }
+
+    [[nodiscard]] auto capacity() const noexcept
+        -> size_type
+    {
+        return _block ? _block->capacity() : 0;
+    }
+
+    void shrink_to_fit()
+    {
+        if (!_block || shared())
+        {
+            return;
+        }
+        if (_block->empty())
+        {
+            _block.reset();
+            return;
+        }
+        _block->shrink_to_fit();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    [[nodiscard]] auto begin() const noexcept
+        -> const_iterator
+    {
+        return get().cbegin();
+    }
+
+    [[nodiscard]] auto end() const noexcept
+        -> const_iterator
+    {
+        return get().cend();
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept
+        -> const_iterator
+    {
+        return get().cbegin();
+    }
+
+    [[nodiscard]] auto cend() const noexcept
+        -> const_iterator
+    {
+        return get().cend();
+    }
+
+    [[nodiscard]] auto at(size_type position) const
+        -> T const &
+    {
+        return get().at(position);
+    }
+
+    [[nodiscard]] auto operator[](size_type position) const noexcept
+        -> T const &
+    {
+        return (*_block)[position];
+    }
+
+    [[nodiscard]] friend bool operator==(cow_vector const & first, cow_vector const & second)
+    {
+        return first._block == second._block || first.get() == second.get();
+    }
+
+    [[nodiscard]] friend bool operator!=(cow_vector const & first, cow_vector const & second)
+    {
+        return !(first == second);
+    }
+
+private:
+
+    [[nodiscard]] static auto empty_vector() noexcept
+        -> vector_type const &
+    {
+        static vector_type const empty{};
+        return empty;
+    }
+};
@@ -0,0 +1,256 @@
+#pragma once
+
+/*
+    Distances (the number of edges of the shortest path) between many vertices at once.
+    Following functionalities are provided:
+
+    find_distances<D>(g, sources)    Return the distances from every source to every vertex of G
+    find_all_distances<D>(g)         Return the distances between all of the pairs of the vertices of G
+
+    Distances are returned in the distance_matrix with the entries of the small unsigned type D (16 bits by default),
+    the largest value of D marks the vertices that can't be reached. If some distance doesn't fit into D,
+    std::nullopt is returned. For the directed graph the distances go along the edges, from the source.
+
+    Multi-source BFS (Then et al.), the sources are taken in batches of 64 or 256 and every vertex keeps
+    one bit per source of the batch, so one pass over the edges advances all of the searches of the batch:
+
+    for each source s_i of the batch {
+        seen[s_i] |= bit(i); visit[s_i] |= bit(i);
+    }
+    for level = 1, 2, ... while some visit[v] is not empty {
+        for each vertex v in G.vertices() with visit[v] not empty
+            for each vertex u in G.adjacentVertices(v)
+                next[u] |= visit[v];
+        for each vertex v in G.vertices() {
+            next[v] &= ~seen[v]; seen[v] |= next[v];
+            for each bit i in next[v]
+                distance[s_i][v] = level;
+        }
+        visit = next; next = empty;
+    }
+
+    NOTE: every level reads every edge once for the whole batch, so on the graphs with the small diameter
+        (like the polyhedra) the batch of 256 sources costs about as much as one BFS. Batches of 256 sources
+        keep 4 words per vertex, the loops over the words are vectorized by the compiler. Batches are
+        independent, they run in parallel and every batch writes only to the rows of its own sources. Batch keeps
+        only the three masks per vertex, the distances go straight into the result, so the memory beyond the result
+        is O(V * W) words per running batch.
+        Every level also goes over all of the vertices, so on the long and thin graphs (paths, strips)
+        one BFS per source can be faster.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "graph_lib_detail.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <assert.h>
+
+template <typename V, typename D>
+struct graph_lib::distance_matrix
+{
+    static_assert(std::is_integral_v<D> && std::is_unsigned_v<D>, "distance has to be the unsigned integer");
+
+    // distance of the vertices that can't be reached from the source
+    static constexpr D unreachable = std::numeric_limits<D>::max();
+
+    // rows of the matrix, in the order they were given
+    std::vector<V> sources;
+    // columns of the matrix, in the order of the vertices in the graph
+    std::vector<V> targets;
+    // distance from sources[i] to targets[j] is at i * targets.size() + j
+    std::vector<D> distances;
+
+    [[nodiscard]] auto distance(std::size_t source, std::size_t target) const noexcept
+        -> D
+    {
+        assert(source < sources.size() && target < targets.size());
+
+        return distances[source * targets.size() + target];
+    }
+};
+
+namespace graph_lib::detail
+{
+    // one bit for every source of the batch
+    template <std::size_t W>
+    using source_mask = std::array<std::uint64_t, W>;
+
+    template <std::size_t W>
+    [[nodiscard]] bool any(source_mask<W> const & mask) noexcept
+    {
+        std::uint64_t bits{};
+        for (auto const word : mask)
+        {
+            bits |= word;
+        }
+        return bits != 0;
+    }
+
+    // position of the lowest set bit, the bits must not be 0
+    [[nodiscard]] inline auto lowest_bit(std::uint64_t bits) noexcept
+        -> std::size_t
+    {
+        assert(bits != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(bits));
+#else
+        std::size_t position{};
+        for (; (bits & 1) == 0; bits >>= 1)
+        {
+            ++position;
+        }
+        return position;
+#endif
+    }
+
+    // runs the BFS from up to 64 * W sources at once, row i of rows gets the distances from sources[i]
+    // returns false if some distance doesn't fit into D
+    template <std::size_t W, typename D>
+    bool multi_source_bfs(compact_adjacency const & adjacency, std::size_t const * sources, std::size_t count, D * rows)
+    {
+        assert(count <= 64 * W);
+
+        auto const vertices = adjacency.num_vertices();
+        std::vector<source_mask<W>> seen(vertices), visit(vertices), next(vertices);
+
+        // distances are written straight into the rows, so the batch only keeps its masks, O(V * W) words
+        std::fill(rows, rows + count * vertices, std::numeric_limits<D>::max());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            seen[sources[i]][i / 64]  |= std::uint64_t{1} << (i % 64);
+            visit[sources[i]][i / 64] |= std::uint64_t{1} << (i % 64);
+            rows[i * vertices + sources[i]] = 0;
+        }
+
+        for (std::size_t level = 1; ; ++level)
+        {
+            for (std::size_t v = 0; v < vertices; ++v)
+            {
+                if (!any(visit[v]))
+                {
+                    continue;
+                }
+                for (auto e = adjacency.offsets[v]; e < adjacency.offsets[v + 1]; ++e)
+                {
+                    auto & target = next[adjacency.targets[e]];
+                    for (std::size_t word = 0; word < W; ++word)
+                    {
+                        target[word] |= visit[v][word];
+                    }
+                }
+            }
+
+            bool reached{};
+            for (std::size_t v = 0; v < vertices; ++v)
+            {
+                for (std::size_t word = 0; word < W; ++word)
+                {
+                    auto bits = next[v][word] & ~seen[v][word];
+                    next[v][word] = bits;
+                    seen[v][word] |= bits;
+
+                    reached = reached || bits != 0;
+                    if (bits != 0 && level >= std::numeric_limits<D>::max())
+                    {
+                        return false;
+                    }
+                    for (; bits != 0; bits &= bits - 1)
+                    {
+                        rows[(word * 64 + lowest_bit(bits)) * vertices + v] = static_cast<D>(level);
+                    }
+                }
+            }
+
+            if (!reached)
+            {
+                break;
+            }
+            std::swap(visit, next);
+            std::fill(std::begin(next), std::end(next), source_mask<W>{});
+        }
+        return true;
+    }
+
+    // batches of 64 * W sources, run in parallel
+    template <std::size_t W, typename D>
+    bool multi_source_distances(compact_adjacency const & adjacency, std::vector<std::size_t> const & sources,
+                                std::vector<D> & distances)
+    {
+        constexpr std::size_t batch = 64 * W;
+        auto const batches = (sources.size() + batch - 1) / batch;
+
+        std::atomic<bool> fits{true};
+        parallel_for(batches, [&](std::size_t begin, std::size_t end)
+        {
+            for (auto b = begin; b < end; ++b)
+            {
+                auto const first = b * batch;
+                auto const count = std::min(batch, sources.size() - first);
+                if (!multi_source_bfs<W>(adjacency, sources.data() + first, count,
+                                         distances.data() + first * adjacency.num_vertices()))
+                {
+                    fits.store(false, std::memory_order_relaxed);
+                }
+            }
+        }, 1);
+
+        return fits.load();
+    }
+}
+
+template <typename D, typename V, bool undirected>
+auto graph_lib::find_distances(graph<V,undirected> const & g, std::vector<V> const & sources)
+    -> std::optional<distance_matrix<V, D>>
+{
+    auto const adjacency = detail::make_compact_adjacency(g);
+    auto const vertices  = adjacency.num_vertices();
+
+    distance_matrix<V, D> ret_val{};
+    ret_val.sources = sources;
+    ret_val.targets.reserve(vertices);
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        ret_val.targets.emplace_back(it->first);
+    }
+
+    std::vector<std::size_t> slots{};
+    slots.reserve(sources.size());
+    for (auto const & source : sources)
+    {
+        auto const found = g.vertex_index().find(source);
+        assert(found != std::cend(g.vertex_index()));
+        slots.emplace_back(found->second);
+    }
+
+    ret_val.distances.resize(sources.size() * vertices);
+
+    // the narrow batch when there are only a few sources, so the words of the empty sources aren't carried
+    auto const fits = sources.size() <= 64 ? detail::multi_source_distances<1>(adjacency, slots, ret_val.distances)
+                                           : detail::multi_source_distances<4>(adjacency, slots, ret_val.distances);
+    if (!fits)
+    {
+        return std::nullopt;
+    }
+    return ret_val;
+}
+
+template <typename D, typename V, bool undirected>
+auto graph_lib::find_all_distances(graph<V,undirected> const & g)
+    -> std::optional<distance_matrix<V, D>>
+{
+    std::vector<V> sources{};
+    sources.reserve(g.num_vertices());
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        sources.emplace_back(it->first);
+    }
+
+    return find_distances<D>(g, sources);
+}
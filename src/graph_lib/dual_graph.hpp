@@ -0,0 +1,285 @@
+#pragma once
+
+/*
+    Dual of the polyhedron: one vertex for every face, two faces are adjacent when they share an edge.
+    Following functionalities are provided:
+
+    dual_graph(faces)            Return the dual of the faces, the vertex i of the dual is faces[i]
+    dual_graph(policy, faces)    Same as above, the edges are bucketed and paired in parallel (see execution.hpp)
+    dual_graph(g, faces)         Same as above, the vertices are numbered by the vertex index of G instead of
+                                 by the new hash map
+
+    Face is the triple (e.g. the output of find_triangular_faces or find_triangles) or any other tuple of
+    the vertices, or the vector of the vertices of the polygon in the order around it. Edges are the pairs
+    of the consecutive vertices, including the last and the first one. Faces should be distinct, faces that
+    share more than one edge are adjacent only once, and the edge of the more than two faces makes all of
+    them adjacent to each other.
+
+    Edges are grouped without comparing the faces with each other:
+
+    number the vertices 0 ... n - 1;
+    for each face f, for each edge (a,b) of f {
+        bucket[min(a,b)].insertLast((max(a,b), f)); // counting sort by the smaller end
+    }
+    for each bucket B {
+        sort B by the larger end; // the sides of the same edge are now next to each other
+        for each run of the equal larger ends, for each two faces f, g of the run
+            D.insertEdge(f, g);
+    }
+
+    NOTE: buckets are the edges of one vertex, so sorting them takes O(degree log degree) and the whole
+        construction O(F + E) for the polyhedra, where the degrees are small.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "graph_lib_detail.hpp"
+#include "execution.hpp"
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <assert.h>
+
+namespace graph_lib::detail
+{
+    // faces with the tuple_size (tuples, arrays) are iterated with std::apply, the others with the range-for
+    template <typename Face, typename = void>
+    struct face_traits
+    {
+        using vertex_type = typename Face::value_type;
+        static constexpr bool tuple_like = false;
+    };
+
+    template <typename Face>
+    struct face_traits<Face, std::void_t<decltype(std::tuple_size<Face>::value)>>
+    {
+        using vertex_type = std::decay_t<std::tuple_element_t<0, Face>>;
+        static constexpr bool tuple_like = true;
+    };
+
+    template <typename Face, typename F>
+    void for_each_face_vertex(Face const & face, F && fn)
+    {
+        if constexpr (face_traits<Face>::tuple_like)
+        {
+            std::apply([&](auto const &... vertex){ (fn(vertex), ...); }, face);
+        }
+        else
+        {
+            for (auto const & vertex : face)
+            {
+                fn(vertex);
+            }
+        }
+    }
+
+    // vertices of the face f are vertices[offsets[f]] ... vertices[offsets[f+1] - 1], numbered 0 ... count - 1
+    struct face_lists
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> vertices;
+        std::size_t              count;
+    };
+
+    template <typename Face, typename Number>
+    auto make_face_lists(std::vector<Face> const & faces, Number && number)
+        -> face_lists
+    {
+        face_lists lists{{0}, {}, 0};
+        lists.offsets.reserve(faces.size() + 1);
+        for (auto const & face : faces)
+        {
+            for_each_face_vertex(face, [&](auto const & vertex)
+            {
+                auto const id = number(vertex);
+                lists.count = std::max(lists.count, id + 1);
+                lists.vertices.emplace_back(id);
+            });
+            lists.offsets.emplace_back(lists.vertices.size());
+        }
+        return lists;
+    }
+
+    // the edge seen from the face, the smaller end is given by the bucket it is in
+    struct face_side
+    {
+        std::size_t larger;
+        std::size_t face;
+    };
+
+    template <bool parallel>
+    auto make_dual_graph(face_lists const & lists)
+        -> graph<std::size_t>
+    {
+        auto const faces = lists.offsets.size() - 1;
+
+        auto const for_each_edge = [&](auto && fn)
+        {
+            for (std::size_t f = 0; f < faces; ++f)
+            {
+                auto const first = lists.offsets[f];
+                auto const last  = lists.offsets[f + 1];
+                for (auto i = first; i < last; ++i)
+                {
+                    auto const a = lists.vertices[i];
+                    auto const b = lists.vertices[i + 1 < last ? i + 1 : first];
+                    // repeated vertex isn't an edge
+                    if (a != b)
+                    {
+                        fn(std::min(a, b), std::max(a, b), f);
+                    }
+                }
+            }
+        };
+
+        // counting sort by the smaller end
+        std::vector<std::size_t> bucket(lists.count + 1);
+        for_each_edge([&](std::size_t smaller, std::size_t, std::size_t){ ++bucket[smaller + 1]; });
+        std::partial_sum(std::begin(bucket), std::end(bucket), std::begin(bucket));
+
+        std::vector<face_side> sides(bucket.back());
+        auto position = bucket;
+        for_each_edge([&](std::size_t smaller, std::size_t larger, std::size_t f){ sides[position[smaller]++] = face_side{larger, f}; });
+
+        auto const by_larger = [](face_side const & first, face_side const & second)
+        {
+            return std::pair{first.larger, first.face} < std::pair{second.larger, second.face};
+        };
+        auto const sort_buckets = [&](std::size_t begin, std::size_t end)
+        {
+            for (auto v = begin; v < end; ++v)
+            {
+                auto const at = [&](std::size_t i){ return std::next(std::begin(sides), static_cast<std::ptrdiff_t>(i)); };
+                std::sort(at(bucket[v]), at(bucket[v + 1]), by_larger);
+            }
+        };
+
+        // every two faces of the run of the same edge, in both directions
+        auto const pair_faces = [&](std::size_t v, auto && fn)
+        {
+            for (auto run = bucket[v]; run < bucket[v + 1]; )
+            {
+                auto end = run + 1;
+                while (end < bucket[v + 1] && sides[end].larger == sides[run].larger)
+                {
+                    ++end;
+                }
+                for (auto i = run; i < end; ++i)
+                {
+                    for (auto j = run; j < end; ++j)
+                    {
+                        if (i != j)
+                        {
+                            fn(sides[i].face, sides[j].face);
+                        }
+                    }
+                }
+                run = end;
+            }
+        };
+
+        std::vector<std::pair<std::size_t, std::size_t>> pairs{};
+        if constexpr (parallel)
+        {
+            parallel_for(lists.count, sort_buckets, 1024);
+            pairs = parallel_emit<std::pair<std::size_t, std::size_t>>(lists.count,
+                [&](std::size_t v)
+                {
+                    std::size_t count{};
+                    pair_faces(v, [&](std::size_t, std::size_t){ ++count; });
+                    return count;
+                },
+                [&](std::size_t v, auto out)
+                {
+                    pair_faces(v, [&](std::size_t f, std::size_t g){ *out++ = std::pair{f, g}; });
+                    return out;
+                }, 1024);
+        }
+        else
+        {
+            sort_buckets(0, lists.count);
+            for (std::size_t v = 0; v < lists.count; ++v)
+            {
+                pair_faces(v, [&](std::size_t f, std::size_t g){ pairs.emplace_back(f, g); });
+            }
+        }
+
+        // neighbor lists of the dual, sorted and without the faces that share more than one edge twice
+        graph<std::size_t>::graph_vector_type adjacency(faces);
+        for (std::size_t f = 0; f < faces; ++f)
+        {
+            adjacency[f].first = f;
+        }
+        for (auto const & [f, g] : pairs)
+        {
+            adjacency[f].second.emplace_back(g);
+        }
+        auto const tidy = [&](std::size_t begin, std::size_t end)
+        {
+            for (auto f = begin; f < end; ++f)
+            {
+                auto & neighbors = adjacency[f].second;
+                std::sort(std::begin(neighbors), std::end(neighbors));
+                neighbors.erase(std::unique(std::begin(neighbors), std::end(neighbors)), std::end(neighbors));
+            }
+        };
+        if constexpr (parallel)
+        {
+            parallel_for(faces, tidy, 1024);
+        }
+        else
+        {
+            tidy(0, faces);
+        }
+
+        return graph<std::size_t>{std::move(adjacency)};
+    }
+
+    // numbers the vertices of the faces in the order they are first seen
+    template <typename Face>
+    auto make_face_lists(std::vector<Face> const & faces)
+        -> face_lists
+    {
+        std::unordered_map<typename face_traits<Face>::vertex_type, std::size_t> numbers{};
+        return make_face_lists(faces, [&](auto const & vertex)
+        {
+            return numbers.emplace(vertex, numbers.size()).first->second;
+        });
+    }
+}
+
+template <typename Face>
+auto graph_lib::dual_graph(std::vector<Face> const & faces)
+    -> graph<std::size_t>
+{
+    return detail::make_dual_graph<false>(detail::make_face_lists(faces));
+}
+
+template <typename ExecutionPolicy, typename Face>
+auto graph_lib::dual_graph(ExecutionPolicy &&, std::vector<Face> const & faces)
+    -> std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, graph<std::size_t>>
+{
+    return detail::make_dual_graph<execution::is_parallel_policy_v<ExecutionPolicy>>(detail::make_face_lists(faces));
+}
+
+// the vertices of the faces are numbered by their slots in the graph
+// asserts that the graph contains the vertices of the faces
+template <typename V, bool undirected, typename Face>
+auto graph_lib::dual_graph(graph<V,undirected> const & g, std::vector<Face> const & faces)
+    -> graph<std::size_t>
+{
+    auto const & index = g.vertex_index();
+    auto lists = detail::make_face_lists(faces, [&](auto const & vertex)
+    {
+        auto const found = index.find(vertex);
+        assert(found != std::cend(index));
+        return found->second;
+    });
+    lists.count = g.num_vertices();
+
+    return detail::make_dual_graph<false>(lists);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/*
+    Execution policies for the algorithms, modeled on std::execution.
+    The standard policies aren't used directly since the parallel standard algorithms
+    need an external backend on most of the toolchains, these ones run on the thread pool
+    of the library (see thread_pool.hpp).
+
+    seq                      Run the algorithm on the calling thread, same as the overload without the policy
+    par                      Split the work into chunks and run them on the thread pool
+    par_unseq                Same as par, the chunks are free to be vectorized
+*/
+
+#include <type_traits>
+
+namespace graph_lib::execution
+{
+    struct sequenced_policy {};
+    struct parallel_policy {};
+    struct parallel_unsequenced_policy {};
+
+    inline constexpr sequenced_policy            seq{};
+    inline constexpr parallel_policy             par{};
+    inline constexpr parallel_unsequenced_policy par_unseq{};
+
+    template <typename T>
+    struct is_execution_policy : std::false_type {};
+
+    template <>
+    struct is_execution_policy<sequenced_policy> : std::true_type {};
+
+    template <>
+    struct is_execution_policy<parallel_policy> : std::true_type {};
+
+    template <>
+    struct is_execution_policy<parallel_unsequenced_policy> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_execution_policy_v = is_execution_policy<std::decay_t<T>>::value;
+
+    // whether the policy allows the work to be spread over several threads
+    template <typename T>
+    inline constexpr bool is_parallel_policy_v = is_execution_policy_v<T>
+                                                 && !std::is_same_v<std::decay_t<T>, sequenced_policy>;
+}
@@ -0,0 +1,484 @@
+#pragma once
+
+/*
+    Triangle listing for the graphs whose edges don't fit into the memory.
+    Only the vertices are kept in the memory (a few words per vertex), the edges are read from the
+    edge source and kept on the disk, the memory used by the edges is bounded by the budget.
+
+    edge_list_source<V>(path)                Edge source that reads the edge list file (see read_edge_list),
+                                             fails if the file can't be read or some line is malformed
+    find_triangles_external<V>(source, fn[, options])
+                                             Call fn(u, v, w) once for every triangle of the graph,
+                                             returns false if the source failed or the spill file couldn't
+                                             be written or read
+
+    Edge source is any callable that takes the visitor and calls visitor(u, v) for every edge of the graph,
+    it is called three times, so it has to produce the same edges every time. Source may return bool,
+    false means that it failed and the whole search fails, before any triangle is reported when it fails
+    in the first pass. Every edge has to be listed once, loops are skipped.
+
+    Algorithm:
+
+    pass 1: count the degree of every vertex;
+    rank the vertices by (degree, first appearance) and orient every edge from the lower to the higher rank,
+    so the out-degree of every vertex is O(sqrt(E));
+    pass 2: count the out-degree of every vertex;
+    split the ranks into the contiguous ranges (partitions) so the out-edges of every range take at most
+    half of the budget;
+    pass 3: write every oriented edge (u, v) to the region of the partition of u in the spill file;
+
+    for each partition P_i {
+        load P_i into the memory as the sorted out-neighbor lists
+        for each partition P_j, j >= i, that some edge of P_i points into {
+            load P_j
+            for each edge (u, v), u in P_i, v in P_j
+                for each w in N+(u) intersected with N+(v)
+                    report (u, v, w)
+        }
+    }
+
+    Every triangle u < v < w (by rank) is reported exactly once, from the partition pair of u and v.
+    Out-degrees give the size of every partition, so all of them share one spill file, every partition
+    in its own region. Pass 3 collects the edges in one buffer of half of the budget, sorts the full buffer
+    by the partition and writes every run at the current end of its region, so only one file is open and
+    the buffers never take more than the budget, no matter how many partitions there are.
+    Regions are read sequentially and at most two partitions are in the memory at the same time.
+    Vertex with more out-edges than half of the budget gets the partition of its own.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph_io.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <assert.h>
+#include <unistd.h>
+
+struct graph_lib::external_memory_options
+{
+    // bytes that the edges are allowed to take in the memory
+    std::size_t memory_budget = std::size_t{256} << 20;
+    // directory for the partition files, the temporary directory of the system when empty
+    std::string directory{};
+};
+
+namespace graph_lib::detail
+{
+    using rank_type = std::uint32_t;
+
+    // calls the edge source, the sources that don't return anything never fail
+    template <typename EdgeSource, typename Visitor>
+    bool run_edge_source(EdgeSource & source, Visitor && visitor)
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<EdgeSource &, Visitor>>)
+        {
+            source(std::forward<Visitor>(visitor));
+            return true;
+        }
+        else
+        {
+            return static_cast<bool>(source(std::forward<Visitor>(visitor)));
+        }
+    }
+
+    // spill file of all of the partitions, the edge is the pair of the ranks and the positions count the edges
+    class spill_file
+    {
+        std::filesystem::path _path;
+        std::FILE *           _file;
+
+    public:
+
+        explicit spill_file(std::filesystem::path path)
+            : _path{std::move(path)}, _file{std::fopen(_path.c_str(), "w+b")}
+        {
+        }
+
+        spill_file(spill_file const &) = delete;
+        spill_file & operator=(spill_file const &) = delete;
+
+        ~spill_file()
+        {
+            if (_file != nullptr)
+            {
+                std::fclose(_file);
+            }
+            std::error_code ignored{};
+            std::filesystem::remove(_path, ignored);
+        }
+
+        [[nodiscard]] bool good() const noexcept
+        {
+            return _file != nullptr && !std::ferror(_file);
+        }
+
+        // writes the edges from the position on
+        bool write(std::size_t position, std::array<rank_type, 2> const * edges, std::size_t count)
+        {
+            return seek(position) && std::fwrite(edges, sizeof(*edges), count, _file) == count;
+        }
+
+        // calls fn(source, target) for the count edges from the position on, in the order they were written
+        template <typename F>
+        bool for_each_edge(std::size_t position, std::size_t count, F && fn)
+        {
+            if (!seek(position))
+            {
+                return false;
+            }
+
+            std::array<rank_type, 2> block[4096];
+            while (count > 0)
+            {
+                auto const wanted = std::min(count, std::size(block));
+                if (std::fread(block, sizeof(block[0]), wanted, _file) != wanted)
+                {
+                    return false;
+                }
+                for (std::size_t i = 0; i < wanted; ++i)
+                {
+                    fn(block[i][0], block[i][1]);
+                }
+                count -= wanted;
+            }
+            return good();
+        }
+
+    private:
+
+        bool seek(std::size_t position)
+        {
+            auto const offset = position * sizeof(std::array<rank_type, 2>);
+            return good() && offset <= static_cast<std::size_t>(std::numeric_limits<long>::max()) &&
+                   std::fseek(_file, static_cast<long>(offset), SEEK_SET) == 0;
+        }
+    };
+
+    // out-neighbor lists of the ranks [first, last), in the compressed sparse row form
+    struct loaded_partition
+    {
+        rank_type              first;
+        rank_type              last;
+        std::vector<std::size_t> offsets;
+        std::vector<rank_type> targets;
+
+        [[nodiscard]] auto neighbors(rank_type rank) const noexcept
+            -> std::pair<rank_type const *, rank_type const *>
+        {
+            auto const * data = targets.data();
+            return {data + offsets[rank - first], data + offsets[rank - first + 1]};
+        }
+    };
+
+    // region is the position of the first edge of the partition in the spill file
+    inline bool load_partition(spill_file & file, std::size_t region, rank_type first, rank_type last,
+                               std::vector<std::size_t> const & out_degrees, loaded_partition & partition)
+    {
+        partition.first = first;
+        partition.last  = last;
+        partition.offsets.assign(std::size_t{last - first} + 1, 0);
+        for (auto rank = first; rank < last; ++rank)
+        {
+            partition.offsets[rank - first + 1] = partition.offsets[rank - first] + out_degrees[rank];
+        }
+        partition.targets.resize(partition.offsets.back());
+
+        std::vector<std::size_t> positions(std::cbegin(partition.offsets), std::cend(partition.offsets) - 1);
+        auto const loaded = file.for_each_edge(region, partition.targets.size(), [&](rank_type source, rank_type target)
+        {
+            partition.targets[positions[source - first]++] = target;
+        });
+
+        for (std::size_t i = 0; i + 1 < partition.offsets.size(); ++i)
+        {
+            std::sort(std::begin(partition.targets) + static_cast<std::ptrdiff_t>(partition.offsets[i]),
+                      std::begin(partition.targets) + static_cast<std::ptrdiff_t>(partition.offsets[i + 1]));
+        }
+
+        return loaded;
+    }
+}
+
+template <typename V>
+auto graph_lib::edge_list_source(std::string path)
+{
+    return [path = std::move(path)](auto && visitor)
+    {
+        std::ifstream input{path};
+        if (!input)
+        {
+            return false;
+        }
+
+        std::istringstream line{};
+        while (detail::next_data_line(input, line))
+        {
+            V u{}, v{};
+            if (!(line >> u >> v) || !detail::at_line_end(line))
+            {
+                return false;
+            }
+            visitor(u, v);
+        }
+        return !input.bad();
+    };
+}
+
+template <typename V, typename EdgeSource, typename F>
+bool graph_lib::find_triangles_external(EdgeSource && source, F && fn, external_memory_options const & options)
+{
+    using detail::rank_type;
+
+    // pass 1, vertices in the order of the first appearance and their degrees
+    std::vector<V> vertices{};
+    std::unordered_map<V, rank_type> ids{};
+    std::vector<std::size_t> degrees{};
+
+    auto const id_of = [&](V const & vertex)
+    {
+        auto const [it, inserted] = ids.emplace(vertex, static_cast<rank_type>(vertices.size()));
+        if (inserted)
+        {
+            assert(vertices.size() < std::numeric_limits<rank_type>::max());
+            vertices.emplace_back(vertex);
+            degrees.emplace_back(0);
+        }
+        return it->second;
+    };
+
+    auto const counted = detail::run_edge_source(source, [&](V const & u, V const & v)
+    {
+        if (u != v)
+        {
+            ++degrees[id_of(u)];
+            ++degrees[id_of(v)];
+        }
+    });
+    if (!counted)
+    {
+        return false;
+    }
+
+    // ranks by (degree, first appearance), ids are replaced by the ranks from here on
+    auto const count = vertices.size();
+    std::vector<rank_type> order(count);
+    std::iota(std::begin(order), std::end(order), rank_type{});
+    std::stable_sort(std::begin(order), std::end(order),
+                     [&](rank_type first, rank_type second){ return degrees[first] < degrees[second]; });
+
+    std::vector<rank_type> rank_of(count);
+    std::vector<V> vertex_of_rank(count);
+    for (rank_type rank = 0; rank < count; ++rank)
+    {
+        rank_of[order[rank]] = rank;
+        vertex_of_rank[rank] = std::move(vertices[order[rank]]);
+    }
+    for (auto & [vertex, id] : ids)
+    {
+        (void) vertex;
+        id = rank_of[id];
+    }
+    std::vector<V>{}.swap(vertices);
+    std::vector<rank_type>{}.swap(order);
+    std::vector<rank_type>{}.swap(rank_of);
+
+    auto const oriented = [&](V const & u, V const & v)
+    {
+        auto const first  = ids.at(u);
+        auto const second = ids.at(v);
+        return first < second ? std::pair{first, second} : std::pair{second, first};
+    };
+
+    // pass 2, out-degrees
+    // the source has to produce the same edges every time, the unknown vertex means that it didn't
+    std::vector<std::size_t> out_degrees(count);
+    bool known{true};
+    auto const is_known = [&](V const & u, V const & v)
+    {
+        known = known && ids.count(u) != 0 && ids.count(v) != 0;
+        return known;
+    };
+    auto const oriented_counted = detail::run_edge_source(source, [&](V const & u, V const & v)
+    {
+        if (u != v && is_known(u, v))
+        {
+            ++out_degrees[oriented(u, v).first];
+        }
+    });
+    if (!oriented_counted || !known)
+    {
+        return false;
+    }
+
+    // partitions, each loaded partition takes at most half of the budget
+    auto const half_budget = std::max<std::size_t>(1, options.memory_budget / 2);
+    std::vector<rank_type> bounds{0};
+    std::vector<rank_type> partition_of(count);
+    std::size_t used{};
+    for (rank_type rank = 0; rank < count; ++rank)
+    {
+        auto const size = out_degrees[rank] * sizeof(rank_type) + sizeof(std::size_t);
+        if (used != 0 && used + size > half_budget)
+        {
+            bounds.emplace_back(rank);
+            used = 0;
+        }
+        used += size;
+        partition_of[rank] = static_cast<rank_type>(bounds.size() - 1);
+    }
+    bounds.emplace_back(static_cast<rank_type>(count));
+    auto const partitions = bounds.size() - 1;
+
+    // pass 3, the oriented edges are written to the regions of their partitions in the spill file
+    auto const directory = options.directory.empty() ? std::filesystem::temp_directory_path()
+                                                     : std::filesystem::path{options.directory};
+    static std::atomic<std::size_t> calls{};
+    auto const name = "graph_lib_spill_" + std::to_string(::getpid()) + "_" + std::to_string(calls++);
+
+    detail::spill_file file{directory / name};
+    if (!file.good())
+    {
+        return false;
+    }
+
+    // regions[i] is the first edge of the partition i, ends[i] is where its next edge goes
+    std::vector<std::size_t> regions(partitions + 1);
+    for (std::size_t i = 0; i < partitions; ++i)
+    {
+        regions[i + 1] = regions[i];
+        for (auto rank = bounds[i]; rank < bounds[i + 1]; ++rank)
+        {
+            regions[i + 1] += out_degrees[rank];
+        }
+    }
+    auto ends = regions;
+
+    using spilled_edge = std::array<rank_type, 2>;
+    std::vector<spilled_edge> buffer{};
+    buffer.reserve(std::max<std::size_t>(1, half_budget / sizeof(spilled_edge)));
+    bool written{true};
+    auto const flush = [&]
+    {
+        std::sort(std::begin(buffer), std::end(buffer), [&](spilled_edge const & first, spilled_edge const & second)
+                  { return partition_of[first[0]] < partition_of[second[0]]; });
+        for (std::size_t run = 0; run < buffer.size() && written; )
+        {
+            auto const partition = partition_of[buffer[run][0]];
+            auto end = run + 1;
+            while (end < buffer.size() && partition_of[buffer[end][0]] == partition)
+            {
+                ++end;
+            }
+            written = ends[partition] + (end - run) <= regions[partition + 1] &&
+                      file.write(ends[partition], buffer.data() + run, end - run);
+            ends[partition] += end - run;
+            run = end;
+        }
+        buffer.clear();
+    };
+
+    auto const distributed = detail::run_edge_source(source, [&](V const & u, V const & v)
+    {
+        if (u != v && is_known(u, v))
+        {
+            auto const [first, second] = oriented(u, v);
+            buffer.emplace_back(spilled_edge{first, second});
+            if (buffer.size() == buffer.capacity())
+            {
+                flush();
+            }
+        }
+    });
+    flush();
+    // every region has to be filled exactly, otherwise the source produced different edges
+    ends.pop_back();
+    if (!distributed || !known || !written || !std::equal(std::cbegin(ends), std::cend(ends), std::cbegin(regions) + 1))
+    {
+        return false;
+    }
+    std::vector<spilled_edge>{}.swap(buffer);
+    std::unordered_map<V, rank_type>{}.swap(ids);
+
+    // partition pairs
+    detail::loaded_partition outer{}, inner{};
+    std::vector<char> reached(partitions);
+    for (std::size_t i = 0; i < partitions; ++i)
+    {
+        if (!detail::load_partition(file, regions[i], bounds[i], bounds[i + 1], out_degrees, outer))
+        {
+            return false;
+        }
+
+        std::fill(std::begin(reached), std::end(reached), 0);
+        for (auto const target : outer.targets)
+        {
+            reached[partition_of[target]] = 1;
+        }
+
+        for (auto j = i; j < partitions; ++j)
+        {
+            if (!reached[j])
+            {
+                continue;
+            }
+
+            auto const & other = (i == j) ? outer : inner;
+            if (i != j && !detail::load_partition(file, regions[j], bounds[j], bounds[j + 1], out_degrees, inner))
+            {
+                return false;
+            }
+
+            for (auto u = outer.first; u < outer.last; ++u)
+            {
+                auto const [u_first, u_last] = outer.neighbors(u);
+                // targets are sorted, so the ones in P_j are contiguous
+                auto const v_first = std::lower_bound(u_first, u_last, other.first);
+                auto const v_last  = std::lower_bound(v_first, u_last, other.last);
+
+                for (auto it = v_first; it != v_last; ++it)
+                {
+                    auto const v = *it;
+                    auto [w_first, w_last] = other.neighbors(v);
+                    // N+(v) only holds ranks above v, so the search in N+(u) can start after v
+                    auto x = it + 1;
+                    while (x != u_last && w_first != w_last)
+                    {
+                        if (*x < *w_first)
+                        {
+                            ++x;
+                        }
+                        else if (*w_first < *x)
+                        {
+                            ++w_first;
+                        }
+                        else
+                        {
+                            fn(vertex_of_rank[u], vertex_of_rank[v], vertex_of_rank[*x]);
+                            ++x;
+                            ++w_first;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// same as above with the default budget and the temporary directory of the system
+template <typename V, typename EdgeSource, typename F>
+bool graph_lib::find_triangles_external(EdgeSource && source, F && fn)
+{
+    return find_triangles_external<V>(std::forward<EdgeSource>(source), std::forward<F>(fn), external_memory_options{});
+}
@@ -0,0 +1,398 @@
+#pragma once
+
+/*
+    Geometric measures of the tetrahedra, e.g. the ones produced by cone_triangulation.
+    Following functionalities are provided:
+
+    measure_tetrahedra(points, T)      Volumes, orientations and centroids of the tetrahedra T, every tetrahedron
+                                       is given by the positions of its corners in points
+    measure_tetrahedra(g, p, S)        Same as above for the tetrahedra S of the vertices of G, the corners are
+                                       taken from the vertex property p of G (see graph_properties.hpp)
+    orient3d(a, b, c, d)               Exact sign of the orientation of d against the plane of a, b, c
+
+    Signed volume of the tetrahedron (p0, p1, p2, p3) is det[p1 - p0, p2 - p0, p3 - p0] / 6, its orientation
+    is the sign of that determinant. Determinants are computed four at a time with AVX2 when the processor
+    supports it (checked once at run time), otherwise one at a time, both kernels give the same results.
+
+    Robustness (Shewchuk, Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates):
+
+    det = determinant in the floating point;
+    bound = (7 + 56 eps) eps * permanent; // permanent is the determinant with all of the terms taken positive
+    if |det| > bound then
+        the sign of det is correct;
+    else
+        det is evaluated exactly as the sum of the non-overlapping doubles (expansion), from the exact differences;
+
+    Only the nearly degenerate tetrahedra get to the exact evaluation, their volume is then the rounded exact value.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <assert.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define GRAPH_LIB_HAS_AVX2_KERNEL 1
+#else
+#define GRAPH_LIB_HAS_AVX2_KERNEL 0
+#endif
+
+struct graph_lib::tetrahedra_measures
+{
+    // signed volume of every tetrahedron
+    std::vector<double> volumes;
+    // exact sign of the orientation of every tetrahedron, -1, 0 or 1
+    std::vector<int> orientations;
+    // centroid of every tetrahedron
+    std::vector<std::array<double, 3>> centroids;
+    // sum of the signed volumes, the volume of the polyhedron when its faces are consistently oriented
+    double signed_volume;
+    // sum of the absolute volumes, the volume of the polyhedron when the apex sees every face from the inside
+    double absolute_volume;
+    // number of the tetrahedra whose orientation had to be evaluated exactly
+    std::size_t exact_evaluations;
+};
+
+namespace graph_lib::detail
+{
+    using point_type       = std::array<double, 3>;
+    using tetrahedron_type = std::array<std::size_t, 4>;
+
+    inline constexpr double epsilon = 0x1p-53;
+    inline constexpr double orient3d_bound = (7.0 + 56.0 * epsilon) * epsilon;
+
+    // exact sum and difference, x + y == a + b (Knuth)
+    inline void two_sum(double a, double b, double & x, double & y) noexcept
+    {
+        x = a + b;
+        auto const b_virtual = x - a;
+        auto const a_virtual = x - b_virtual;
+        y = (a - a_virtual) + (b - b_virtual);
+    }
+
+    // exact product, x + y == a * b
+    inline void two_product(double a, double b, double & x, double & y) noexcept
+    {
+        x = a * b;
+        y = std::fma(a, b, -x);
+    }
+
+    // exact number as the sum of the non-overlapping doubles, ordered by the increasing magnitude, zeros are dropped
+    class expansion
+    {
+        std::vector<double> _components;
+
+    public:
+
+        expansion() = default;
+
+        explicit expansion(double value)
+        {
+            grow(value);
+        }
+
+        // exact difference of the two doubles
+        [[nodiscard]] static auto difference(double a, double b)
+            -> expansion
+        {
+            double x{}, y{};
+            two_sum(a, -b, x, y);
+            expansion result{y};
+            result.grow(x);
+            return result;
+        }
+
+        // adds the double (Grow-Expansion)
+        void grow(double value)
+        {
+            auto q = value;
+            std::vector<double> grown{};
+            grown.reserve(_components.size() + 1);
+            for (auto const component : _components)
+            {
+                double sum{}, error{};
+                two_sum(q, component, sum, error);
+                if (error != 0.0)
+                {
+                    grown.emplace_back(error);
+                }
+                q = sum;
+            }
+            if (q != 0.0)
+            {
+                grown.emplace_back(q);
+            }
+            _components = std::move(grown);
+        }
+
+        [[nodiscard]] friend auto operator+(expansion first, expansion const & second)
+            -> expansion
+        {
+            for (auto const component : second._components)
+            {
+                first.grow(component);
+            }
+            return first;
+        }
+
+        [[nodiscard]] friend auto operator-(expansion first, expansion const & second)
+            -> expansion
+        {
+            for (auto const component : second._components)
+            {
+                first.grow(-component);
+            }
+            return first;
+        }
+
+        [[nodiscard]] friend auto operator*(expansion const & first, expansion const & second)
+            -> expansion
+        {
+            expansion result{};
+            for (auto const a : first._components)
+            {
+                for (auto const b : second._components)
+                {
+                    double x{}, y{};
+                    two_product(a, b, x, y);
+                    result.grow(y);
+                    result.grow(x);
+                }
+            }
+            return result;
+        }
+
+        // the largest component decides the sign
+        [[nodiscard]] auto sign() const noexcept
+            -> int
+        {
+            if (_components.empty())
+            {
+                return 0;
+            }
+            return _components.back() > 0.0 ? 1 : -1;
+        }
+
+        [[nodiscard]] auto estimate() const noexcept
+            -> double
+        {
+            double sum{};
+            for (auto const component : _components)
+            {
+                sum += component;
+            }
+            return sum;
+        }
+    };
+
+    // det[a - d, b - d, c - d] evaluated exactly
+    inline auto orient3d_exact(point_type const & a, point_type const & b, point_type const & c, point_type const & d)
+        -> expansion
+    {
+        auto const adx = expansion::difference(a[0], d[0]), ady = expansion::difference(a[1], d[1]), adz = expansion::difference(a[2], d[2]);
+        auto const bdx = expansion::difference(b[0], d[0]), bdy = expansion::difference(b[1], d[1]), bdz = expansion::difference(b[2], d[2]);
+        auto const cdx = expansion::difference(c[0], d[0]), cdy = expansion::difference(c[1], d[1]), cdz = expansion::difference(c[2], d[2]);
+
+        return adz * (bdx * cdy - cdx * bdy)
+             + bdz * (cdx * ady - adx * cdy)
+             + cdz * (adx * bdy - bdx * ady);
+    }
+
+    // det[a - d, b - d, c - d] in the floating point and its error bound
+    inline void orient3d_filtered(point_type const & a, point_type const & b, point_type const & c, point_type const & d,
+                                  double & det, double & bound) noexcept
+    {
+        auto const adx = a[0] - d[0], bdx = b[0] - d[0], cdx = c[0] - d[0];
+        auto const ady = a[1] - d[1], bdy = b[1] - d[1], cdy = c[1] - d[1];
+        auto const adz = a[2] - d[2], bdz = b[2] - d[2], cdz = c[2] - d[2];
+
+        auto const bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        auto const cdxady = cdx * ady, adxcdy = adx * cdy;
+        auto const adxbdy = adx * bdy, bdxady = bdx * ady;
+
+        det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+        bound = orient3d_bound * ((std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+                                + (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+                                + (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz));
+    }
+
+    // fills the measures of the tetrahedron i from the filtered determinant, falls back to the exact one
+    inline void finish_tetrahedron(std::vector<point_type> const & points, tetrahedron_type const & t,
+                                   double det, double bound, std::size_t i, tetrahedra_measures & measures)
+    {
+        if (std::fabs(det) > bound)
+        {
+            measures.orientations[i] = det > 0.0 ? 1 : -1;
+        }
+        else
+        {
+            // det[p1 - p0, p2 - p0, p3 - p0] is det[a - d, b - d, c - d] with (a, b, c, d) = (p1, p2, p3, p0)
+            auto const exact = orient3d_exact(points[t[1]], points[t[2]], points[t[3]], points[t[0]]);
+            measures.orientations[i] = exact.sign();
+            det = exact.estimate();
+            ++measures.exact_evaluations;
+        }
+        measures.volumes[i] = det / 6.0;
+    }
+
+    // one tetrahedron at a time
+    inline void measure_tetrahedra_scalar(std::vector<point_type> const & points, std::vector<tetrahedron_type> const & T,
+                                          std::size_t first, tetrahedra_measures & measures)
+    {
+        for (auto i = first; i < T.size(); ++i)
+        {
+            auto const & t = T[i];
+            double det{}, bound{};
+            orient3d_filtered(points[t[1]], points[t[2]], points[t[3]], points[t[0]], det, bound);
+            finish_tetrahedron(points, t, det, bound, i, measures);
+
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                measures.centroids[i][axis] = (points[t[0]][axis] + points[t[1]][axis]
+                                             + points[t[2]][axis] + points[t[3]][axis]) * 0.25;
+            }
+        }
+    }
+
+#if GRAPH_LIB_HAS_AVX2_KERNEL
+    [[nodiscard]] inline bool has_avx2() noexcept
+    {
+        static bool const supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    __attribute__((target("avx2")))
+    inline auto absolute(__m256d value) noexcept
+        -> __m256d
+    {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+    }
+
+    // four tetrahedra at a time, the operations are the same as in the scalar kernel, so are the results
+    // returns the number of the tetrahedra measured, the rest is left for the scalar kernel
+    __attribute__((target("avx2")))
+    inline auto measure_tetrahedra_avx2(std::vector<point_type> const & points, std::vector<tetrahedron_type> const & T,
+                                        tetrahedra_measures & measures)
+        -> std::size_t
+    {
+        static_assert(sizeof(point_type) == 3 * sizeof(double), "points have to be packed");
+
+        auto const * const coordinates = points.data()->data();
+        std::size_t i{};
+        for (; i + 4 <= T.size(); i += 4)
+        {
+            // coordinates of the corner k of the four tetrahedra, one tetrahedron per lane
+            __m256d p[4][3];
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                auto const offsets = _mm256_set_epi64x(static_cast<long long>(T[i + 3][k] * 3), static_cast<long long>(T[i + 2][k] * 3),
+                                                       static_cast<long long>(T[i + 1][k] * 3), static_cast<long long>(T[i][k] * 3));
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    p[k][axis] = _mm256_i64gather_pd(coordinates + axis, offsets, 8);
+                }
+            }
+
+            // (a, b, c, d) = (p1, p2, p3, p0)
+            auto const adx = _mm256_sub_pd(p[1][0], p[0][0]), bdx = _mm256_sub_pd(p[2][0], p[0][0]), cdx = _mm256_sub_pd(p[3][0], p[0][0]);
+            auto const ady = _mm256_sub_pd(p[1][1], p[0][1]), bdy = _mm256_sub_pd(p[2][1], p[0][1]), cdy = _mm256_sub_pd(p[3][1], p[0][1]);
+            auto const adz = _mm256_sub_pd(p[1][2], p[0][2]), bdz = _mm256_sub_pd(p[2][2], p[0][2]), cdz = _mm256_sub_pd(p[3][2], p[0][2]);
+
+            auto const bdxcdy = _mm256_mul_pd(bdx, cdy), cdxbdy = _mm256_mul_pd(cdx, bdy);
+            auto const cdxady = _mm256_mul_pd(cdx, ady), adxcdy = _mm256_mul_pd(adx, cdy);
+            auto const adxbdy = _mm256_mul_pd(adx, bdy), bdxady = _mm256_mul_pd(bdx, ady);
+
+            auto const det = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(adz, _mm256_sub_pd(bdxcdy, cdxbdy)),
+                                                         _mm256_mul_pd(bdz, _mm256_sub_pd(cdxady, adxcdy))),
+                                           _mm256_mul_pd(cdz, _mm256_sub_pd(adxbdy, bdxady)));
+            auto const permanent = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(absolute(bdxcdy), absolute(cdxbdy)), absolute(adz)),
+                                                               _mm256_mul_pd(_mm256_add_pd(absolute(cdxady), absolute(adxcdy)), absolute(bdz))),
+                                                 _mm256_mul_pd(_mm256_add_pd(absolute(adxbdy), absolute(bdxady)), absolute(cdz)));
+            auto const bound = _mm256_mul_pd(_mm256_set1_pd(orient3d_bound), permanent);
+
+            alignas(32) double dets[4], bounds[4], centroids[3][4];
+            _mm256_store_pd(dets, det);
+            _mm256_store_pd(bounds, bound);
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                auto const sum = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(p[0][axis], p[1][axis]), p[2][axis]), p[3][axis]);
+                _mm256_store_pd(centroids[axis], _mm256_mul_pd(sum, _mm256_set1_pd(0.25)));
+            }
+
+            for (std::size_t lane = 0; lane < 4; ++lane)
+            {
+                finish_tetrahedron(points, T[i + lane], dets[lane], bounds[lane], i + lane, measures);
+                measures.centroids[i + lane] = {centroids[0][lane], centroids[1][lane], centroids[2][lane]};
+            }
+        }
+        return i;
+    }
+#endif
+}
+
+inline auto graph_lib::orient3d(std::array<double, 3> const & a, std::array<double, 3> const & b,
+                                std::array<double, 3> const & c, std::array<double, 3> const & d)
+    -> int
+{
+    double det{}, bound{};
+    detail::orient3d_filtered(a, b, c, d, det, bound);
+    if (std::fabs(det) > bound)
+    {
+        return det > 0.0 ? 1 : -1;
+    }
+    return detail::orient3d_exact(a, b, c, d).sign();
+}
+
+inline auto graph_lib::measure_tetrahedra(std::vector<std::array<double, 3>> const & points,
+                                          std::vector<std::array<std::size_t, 4>> const & T)
+    -> tetrahedra_measures
+{
+    tetrahedra_measures measures{std::vector<double>(T.size()), std::vector<int>(T.size()),
+                                 std::vector<std::array<double, 3>>(T.size()), 0.0, 0.0, 0};
+
+    std::size_t first{};
+#if GRAPH_LIB_HAS_AVX2_KERNEL
+    if (!T.empty() && detail::has_avx2())
+    {
+        first = detail::measure_tetrahedra_avx2(points, T, measures);
+    }
+#endif
+    detail::measure_tetrahedra_scalar(points, T, first, measures);
+
+    for (auto const volume : measures.volumes)
+    {
+        measures.signed_volume   += volume;
+        measures.absolute_volume += std::fabs(volume);
+    }
+    return measures;
+}
+
+// the tetrahedra are translated to the slots of their corners, the points are the values of the property
+// asserts whether the graph contains the corners
+template <typename V, bool undirected>
+auto graph_lib::measure_tetrahedra(graph<V,undirected> const & g, vertex_property<std::array<double, 3>> position,
+                                   std::vector<std::tuple<V,V,V,V>> const & S)
+    -> tetrahedra_measures
+{
+    auto const & index = g.vertex_index();
+    auto const slot = [&index](V const & vertex)
+    {
+        auto const found = index.find(vertex);
+        assert(found != std::cend(index));
+        return found->second;
+    };
+
+    std::vector<std::array<std::size_t, 4>> T{};
+    T.reserve(S.size());
+    for (auto const & [q, u, v, w] : S)
+    {
+        T.push_back({slot(q), slot(u), slot(v), slot(w)});
+    }
+
+    return measure_tetrahedra(g.vertex_values(position), T);
+}
@@ -8,29 +8,163 @@
     
     num_vertices()           Return the number of vertices in G
     num_edges()              Return the number of edges in G
-    vertices()               Return an iterator of the vertices of G
-    edges()                  Return an iterator of the edges of G
+    vertices()               Return the view of the vertices of G
+    edges()                  Return the view of the edges of G, every undirected edge once
 
     degree(v)                Return the degree of v
     adjacent_vertices(v)     Return an iterator of the vertices adjacent to v
-    incident_edges(v)        Return an iterator of the edges incident upon v
+    incident_edges(v)        Return the view of the edges incident upon v
     opposite(v,e)            Return the endpoint of edge e distinct from v
     are_adjacent(v,w)        Return whether vertices v and w are adjacent 
+    degree(first, last, out)
+                             Batched degree, writes the degree of every vertex in [first, last) to out
+    are_adjacent(first, last, out)
+                             Batched are_adjacent, writes the answer for every pair in [first, last) to out
 
     insert_edge(v,w)         Insert and return an undirected edge between vertices v and w
     insert_vertex(v)         Insert and return a new (isolated) numbering
                              vertex v storing the object o at this position 
     remove_vertex(v)         Remove vertex v and all its incident edges 
     remove_edge(e)           Remove edge 
+    apply(batch)             Apply the recorded insertions and removals at once (see mutation_batch.hpp), returns false
+                             and leaves G untouched if some operation of the batch isn't valid for G
+    snapshot()               Return a copy of G that shares the neighbor lists with G
+
+    reserve_vertices(n)      Reserve the room for n vertices in the storage and in the index
+    reserve_edges(v, n)      Reserve the room for n neighbors of v
+    reserve_edges(n)         Hint that G will hold about n edges, every list gets the room for the average degree
+    shrink_to_fit()          Release the capacity that isn't used
+    memory_usage()           Return the bytes used and allocated by the vertices, the neighbor lists, the index
+                             and the properties
+
+    add_vertex_property<T>(d)        Add the column of the values of type T for the vertices, all set to d
+    add_edge_property<T>(d)          Add the column of the values of type T for the edges, all set to d
+    vertex_values(p)                 Return the values of the vertex property, indexed by the slot of the vertex
+    mutable_vertex_values(p)         Same as above, for the modification of the values
+    vertex_value(p, v)               Return the value of the vertex property for v
+    set_vertex_value(p, v, x)        Set the value of the vertex property for v
+    edge_values(p, v)                Return the values of the edge property for the edges of v, parallel to
+                                     adjacent_vertices(v)
+    edge_value(p, v, w)              Return the value of the edge property for the edge (v, w)
+    set_edge_value(p, v, w, x)       Set the value of the edge property for the edge (v, w), on both ends when undirected
+
+    id()                     Return the number that identifies G among all of the graphs of the process
+    version()                Return the number of the structural modifications of G so far
+
+    graph(list)              Build G from the adjacency list, the list is trusted
+    graph(list, report)      Build G from the adjacency list only if it passes the validation
+                             (see graph_validation.hpp), otherwise G is empty
+
+    Neighbor lists are copy-on-write (see cow_vector.hpp), so copying the graph only copies the
+    vertices and the pointers to the lists. The list is copied the first time one of the graphs
+    that share it modifies it, lists that are never modified are never copied.
+
+    Every vertex is indexed by its position in the adjacency list (vertex_index()), so looking up
+    the vertex takes O(1) expected time and node_type has to be hashable. The index is kept up to date
+    by every member function, vertices must not be renamed trough the mutable iterators.
+    The index is shared between the copies in the same way as the neighbor lists.
+
+    Every insert_*, remove_* and sort_vertices_by_degree increments the version, so (id(), version()) changes
+    whenever the structure of G may have changed (see result_cache.hpp). Copies get the new id, the moved G
+    takes the id with it and the moved-from G gets the new one. Modifications through the mutable iterators
+    and of the property values aren't counted.
+
+    Views (see graph_views.hpp) are lazy, they iterate over the adjacency list in place and never allocate.
+
+    Properties are stored as columns (see graph_properties.hpp) that every member function keeps in the sync
+    with the vertices and the neighbor lists, so the geometric passes can stream over the contiguous values
+    instead of looking them up in a side map. Columns are shared between the copies as well.
 */
 
 
 #include "graph_lib_base.hpp"
+#include "cow_vector.hpp"
+#include "graph_validation.hpp"
+#include "graph_properties.hpp"
+#include "graph_views.hpp"
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <type_traits>
+#include <unordered_map>
+#include <memory>
+#include <iterator>
+#include <numeric>
 #include <assert.h>
 
+// bytes used by the elements and allocated for them, for every part of the graph
+// heap memory owned by the vertices themselves (e.g. by strings) isn't counted
+struct graph_lib::graph_memory_usage
+{
+    struct bytes
+    {
+        std::size_t used;
+        std::size_t allocated;
+    };
+
+    // vertices and the handles of their lists
+    bytes vertices;
+    // blocks of the neighbor lists, including the vector and the reference counts of every block
+    // blocks shared with the snapshots are counted by every graph that shares them
+    bytes neighbors;
+    // vertex index, nodes and buckets of the hash map are estimated for the usual node based map
+    bytes index;
+    // vertex and edge property columns
+    bytes properties;
+
+    [[nodiscard]] auto total() const noexcept
+        -> bytes
+    {
+        return bytes{vertices.used + neighbors.used + index.used + properties.used,
+                     vertices.allocated + neighbors.allocated + index.allocated + properties.allocated};
+    }
+};
+
+namespace graph_lib::detail
+{
+    // unique number of the object, the copy is a new object so it gets the new number
+    // the move hands the number over to the destination, the source is left with the new number,
+    // so its stale results aren't found under the old one
+    class graph_identity
+    {
+        std::uint64_t _value;
+
+        [[nodiscard]] static auto next() noexcept
+            -> std::uint64_t
+        {
+            static std::atomic<std::uint64_t> counter{};
+            return ++counter;
+        }
+
+    public:
+
+        graph_identity() noexcept : _value{next()} {}
+        graph_identity(graph_identity const &) noexcept : _value{next()} {}
+
+        graph_identity(graph_identity && other) noexcept : _value{other._value} { other._value = next(); }
+
+        graph_identity & operator=(graph_identity const &) noexcept
+        {
+            _value = next();
+            return *this;
+        }
+
+        graph_identity & operator=(graph_identity && other) noexcept
+        {
+            _value       = other._value;
+            other._value = next();
+            return *this;
+        }
+
+        [[nodiscard]] auto value() const noexcept
+            -> std::uint64_t
+        {
+            return _value;
+        }
+    };
+}
+
 template <typename V, bool undirected>
 class graph_lib::graph
 {
@@ -43,28 +177,51 @@ public:
                               V >;
     using graph_vector_type = std::vector<std::pair <node_type, std::vector<node_type>>>;
     using edges_vector_type = std::vector<node_type>;
+    using edges_block_type  = cow_vector<node_type>;
+    using storage_type      = std::vector<std::pair <node_type, edges_block_type>>;
 
-    using vertices_size_type = typename graph_vector_type::size_type;
+    using vertices_size_type = typename storage_type::size_type;
     using edges_size_type    = typename edges_vector_type::size_type;
+    using vertex_index_type  = std::unordered_map<node_type, vertices_size_type>;
+
+    using edge_type            = edge<node_type, undirected>;
+    using vertex_range         = detail::iterator_range<detail::vertex_iterator<typename storage_type::const_iterator>>;
+    using edge_range           = detail::iterator_range<detail::edge_iterator<typename storage_type::const_iterator,
+                                                                              vertex_index_type, undirected>>;
+    using incident_edge_range  = detail::iterator_range<detail::incident_edge_iterator<node_type, undirected>>;
 
 private:
 
+    // how many queries ahead the batched queries start loading the neighbor lists
+    static constexpr std::size_t prefetch_distance = 8;
+    // groups of fewer adjacency queries than this, or against lists shorter than twice this, are scanned
+    // instead of sorted
+    static constexpr std::size_t scan_threshold = 8;
+
     // member variables
 
-    graph_vector_type _adjacency_list;
-    edges_size_type   _number_of_edges;
+    storage_type      _adjacency_list;
+    edges_size_type   _number_of_edges{};
+    std::shared_ptr<vertex_index_type> _vertex_index;
+    // room reserved for every new neighbor list, see reserve_edges
+    edges_size_type   _expected_degree{};
+    // property columns, shared with the copies until one of them modifies the column
+    std::vector<std::shared_ptr<detail::property_column>> _vertex_columns;
+    std::vector<std::shared_ptr<detail::property_column>> _edge_columns;
+    detail::graph_identity _identity;
+    std::uint64_t          _version{};
 
 public:
 
 // rule of five plus default virtual destructor    
 #pragma region rule_of_five
 
-    explicit graph() noexcept(std::is_nothrow_default_constructible_v<graph_vector_type>) = default;
-    explicit graph(graph const &) noexcept(std::is_nothrow_copy_constructible_v<graph_vector_type>) = default;
-    explicit graph(graph &&) noexcept(std::is_nothrow_move_constructible_v<graph_vector_type>) = default;
+    explicit graph() noexcept(std::is_nothrow_default_constructible_v<storage_type>) = default;
+    explicit graph(graph const &) noexcept(std::is_nothrow_copy_constructible_v<storage_type>) = default;
+    explicit graph(graph &&) noexcept(std::is_nothrow_move_constructible_v<storage_type>) = default;
 
-    graph & operator=(graph const &) noexcept(std::is_nothrow_copy_assignable_v<graph_vector_type>) = default;
-    graph & operator=(graph &&) noexcept(std::is_nothrow_move_assignable_v<graph_vector_type>) = default;
+    graph & operator=(graph const &) noexcept(std::is_nothrow_copy_assignable_v<storage_type>) = default;
+    graph & operator=(graph &&) noexcept(std::is_nothrow_move_assignable_v<storage_type>) = default;
 
     virtual ~graph() = default;
 
@@ -72,14 +229,16 @@ public:
     
     // constructors that take an adjacency list as argument
     explicit graph(graph_vector_type const & adjacency_list) 
-                noexcept(std::is_nothrow_copy_constructible_v<graph_vector_type>)
-                    : _adjacency_list{adjacency_list}, _number_of_edges{}
+                    : _adjacency_list{}, _number_of_edges{}, _vertex_index{}, _expected_degree{},
+                      _vertex_columns{}, _edge_columns{}, _identity{}, _version{}
     {
-        for (auto & [vertex, edges] : _adjacency_list)
+        _adjacency_list.reserve(std::size(adjacency_list));
+        for (auto const & [vertex, edges] : adjacency_list)
         {
-            (void) vertex;
             _number_of_edges = _number_of_edges + std::size(edges);
+            _adjacency_list.emplace_back(vertex, edges_block_type{edges});
         }
+        rebuild_vertex_index();
 
         if constexpr (undirected == true)
         {
@@ -88,14 +247,17 @@ public:
     }
 
     explicit graph(graph_vector_type && adjacency_list) 
-                noexcept(std::is_nothrow_move_constructible_v<graph_vector_type>)
-                    : _adjacency_list{std::move(adjacency_list)}, _number_of_edges{}
+                    : _adjacency_list{}, _number_of_edges{}, _vertex_index{}, _expected_degree{},
+                      _vertex_columns{}, _edge_columns{}, _identity{}, _version{}
     {
-        for (auto & [vertex, edges] : _adjacency_list)
+        _adjacency_list.reserve(std::size(adjacency_list));
+        for (auto & [vertex, edges] : adjacency_list)
         {
-            (void) vertex;
             _number_of_edges = _number_of_edges + std::size(edges);
+            _adjacency_list.emplace_back(std::move(vertex), edges_block_type{std::move(edges)});
         }
+        adjacency_list.clear();
+        rebuild_vertex_index();
 
         if constexpr (undirected == true)
         {
@@ -103,55 +265,78 @@ public:
         }
     }
 
+    // validating constructor, the adjacency list is checked before it is taken over
+    // when the report isn't valid the graph stays empty and the adjacency list is left untouched
+    explicit graph(graph_vector_type && adjacency_list, validation_report<node_type> & report)
+                    : _adjacency_list{}, _number_of_edges{}, _vertex_index{}, _expected_degree{},
+                      _vertex_columns{}, _edge_columns{}, _identity{}, _version{}
+    {
+        report = detail::validate_adjacency_list<undirected>(adjacency_list);
+
+        if (report.valid())
+        {
+            *this = graph{std::move(adjacency_list)};
+        }
+    }
+
+    // returns the copy of the graph, neighbor lists are shared until one of the graphs modifies them
+    // equivalent to the copy constructor, the name only makes the intent visible
+    [[nodiscard]] auto snapshot() const
+        -> graph
+    {
+        return graph{*this};
+    }
+
     // all of the required iterators
-    // by default, you iterate trough the std::pair<V, std::vector<V>> where V is the vertex
-    // and vector contains all of the adjacent vertices to V
+    // by default, you iterate trough the std::pair<node_type, cow_vector<node_type>> where the first is the vertex
+    // and the second holds all of the adjacent vertices to it, the list is read trough get() (or the const
+    // iterators of cow_vector) and changed only trough mutate(), which copies the list first if it is shared
     #pragma region iterators
     
     [[nodiscard]] auto begin() noexcept (noexcept (std::begin(_adjacency_list) ) )  
-        -> typename graph_vector_type::iterator
+        -> typename storage_type::iterator
     {
         return std::begin(_adjacency_list);
     }
 
     [[nodiscard]] auto const cbegin() const noexcept (noexcept (std::cbegin(_adjacency_list) ) ) 
-        -> typename graph_vector_type::const_iterator
+        -> typename storage_type::const_iterator
     {
         return std::cbegin(_adjacency_list);
     }
 
     [[nodiscard]] auto end() noexcept (noexcept (std::end(_adjacency_list) ) )
-        -> typename graph_vector_type::iterator
+        -> typename storage_type::iterator
     {
         return std::end(_adjacency_list);
     }
 
     [[nodiscard]] auto const cend() const noexcept (noexcept (std::cend(_adjacency_list) ) )
-        -> typename graph_vector_type::const_iterator
+        -> typename storage_type::const_iterator
     {
         return std::cend(_adjacency_list);
     }
 
     [[nodiscard]] auto rbegin() noexcept (noexcept (std::rbegin(_adjacency_list) ) )
-        -> typename graph_vector_type::reverse_iterator
+        -> typename storage_type::reverse_iterator
     {
         return std::rbegin(_adjacency_list);
     }
 
     [[nodiscard]] auto const crbegin() const noexcept (noexcept (std::crbegin(_adjacency_list) ) )
-        -> typename graph_vector_type::const_reverse_iterator
+        -> typename storage_type::const_reverse_iterator
     {
         return std::crbegin(_adjacency_list);
     }
 
     [[nodiscard]] auto rend() noexcept (noexcept (std::rend(_adjacency_list) ) )
-        -> typename graph_vector_type::reverse_iterator
+        -> typename storage_type::reverse_iterator
     {
         return std::rend(_adjacency_list);
     }
 
     [[nodiscard]] auto const crend() const noexcept (noexcept (std::crend(_adjacency_list) ) ) 
-        -> typename graph_vector_type::const_reverse_iterator
+        -> typename storage_type::const_reverse_iterator
     {
         return std::crend(_adjacency_list);
     }
@@ -183,12 +368,229 @@ public:
 
     // returns the vector of adjacent vertices of the vertex
     // asserts whether the graph contains that vertex
-    [[nodiscard]] constexpr decltype(auto) adjacent_vertices(V const & vertex) const
+    [[nodiscard]] constexpr auto adjacent_vertices(V const & vertex) const
         -> edges_vector_type const &
     {
         auto const it = assert_has_vertex(vertex, true);
 
-        return it->second;
+        return it->second.get();
+    }
+
+    // returns the view of the vertices, in the iteration order of the graph
+    [[nodiscard]] auto vertices() const noexcept
+        -> vertex_range
+    {
+        using iterator = typename vertex_range::iterator_type;
+        return vertex_range{iterator{std::cbegin(_adjacency_list)}, iterator{std::cend(_adjacency_list)}};
+    }
+
+    // returns the view of the edges, the undirected edge is reported once, from the end that comes first
+    [[nodiscard]] auto edges() const noexcept
+        -> edge_range
+    {
+        using iterator = typename edge_range::iterator_type;
+        return edge_range{iterator{std::cbegin(_adjacency_list), std::cend(_adjacency_list), vertex_index()},
+                          iterator{std::cend(_adjacency_list)}};
+    }
+
+    // returns the view of the edges of the vertex, the vertex is the source of all of them
+    // asserts whether the graph contains that vertex
+    [[nodiscard]] auto incident_edges(V const & vertex) const
+        -> incident_edge_range
+    {
+        auto const it = assert_has_vertex(vertex, true);
+
+        using iterator = typename incident_edge_range::iterator_type;
+        auto const & edges = it->second.get();
+        return incident_edge_range{iterator{&it->first, edges.data()}, iterator{&it->first, edges.data() + edges.size()}};
+    }
+
+    // returns the endpoint of the edge distinct from the vertex
+    // asserts that the vertex is one of the endpoints
+    [[nodiscard]] auto opposite(V const & vertex, edge_type const & e) const
+        -> node_type const &
+    {
+        return e.opposite(vertex);
+    }
+
+    // returns the number that identifies the graph, no other graph of the process has the same one
+    [[nodiscard]] auto id() const noexcept
+        -> std::uint64_t
+    {
+        return _identity.value();
+    }
+
+    // returns the number of the structural modifications so far
+    [[nodiscard]] auto version() const noexcept
+        -> std::uint64_t
+    {
+        return _version;
+    }
+
+    // returns the map from every vertex to its position in the iteration order
+    [[nodiscard]] auto vertex_index() const noexcept
+        -> vertex_index_type const &
+    {
+        static vertex_index_type const empty{};
+        return _vertex_index ? *_vertex_index : empty;
+    }
+
+    // batched degree, writes the degree of every vertex in [first, last) to out, in the same order
+    // asserts whether the graph contains the vertices
+    template <typename InputIt, typename OutputIt>
+    auto degree(InputIt first, InputIt last, OutputIt out) const
+        -> OutputIt
+    {
+        std::vector<vertices_size_type> slots{};
+        for (; first != last; ++first)
+        {
+            slots.emplace_back(vertex_slot(assert_has_vertex(*first, true)));
+        }
+
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+            if (i + prefetch_distance < slots.size())
+            {
+                detail::prefetch(_adjacency_list[slots[i + prefetch_distance]].second.block());
+            }
+            *out++ = _adjacency_list[slots[i]].second.size();
+        }
+
+        return out;
+    }
+
+    // batched are_adjacent, [first, last) is the range of pairs of vertices
+    // writes whether the vertices of every pair are adjacent to out, in the same order
+    // asserts whether the graph contains the vertices
+    template <typename InputIt, typename OutputIt>
+    auto are_adjacent(InputIt first, InputIt last, OutputIt out) const
+        -> OutputIt
+    {
+        std::vector<std::pair<vertices_size_type, vertices_size_type>> queries{};
+        for (; first != last; ++first)
+        {
+            auto const & [node_a, node_b] = *first;
+            queries.emplace_back(vertex_slot(assert_has_vertex(node_a, true)),
+                                 vertex_slot(assert_has_vertex(node_b, true)));
+        }
+
+        std::vector<char> adjacent(queries.size(), true);
+        keep_contained(queries, adjacent);
+
+        if constexpr (undirected == true)
+        {
+            for (auto & [node_a, node_b] : queries)
+            {
+                std::swap(node_a, node_b);
+            }
+            keep_contained(queries, adjacent);
+        }
+
+        return std::transform(std::cbegin(adjacent), std::cend(adjacent), out,
+                              [](char value){ return value != 0; });
+    }
+
+    // reserves the room for count vertices, inserting them then doesn't reallocate the storage or the index
+    void reserve_vertices(vertices_size_type count)
+    {
+        _adjacency_list.reserve(count);
+        mutable_vertex_index().reserve(count);
+    }
+
+    // reserves the room for count neighbors of the vertex
+    // asserts whether the graph contains that vertex
+    void reserve_edges(V const & vertex, edges_size_type count)
+    {
+        auto it = assert_has_vertex(vertex, true);
+
+        it->second.mutate().reserve(count);
+    }
+
+    // hint that the graph will hold about count edges, spread over the vertices it has or has reserved
+    // the lists that are shorter get the room for the average degree now, the lists of the vertices
+    // inserted later get it with their first edge, lists shared with the snapshots are left alone
+    void reserve_edges(edges_size_type count)
+    {
+        auto const vertices = std::max<vertices_size_type>({_adjacency_list.capacity(), _adjacency_list.size(), 1});
+        auto const ends = undirected ? 2 * count : count;
+        _expected_degree = (ends + vertices - 1) / vertices;
+
+        for (auto & [vertex, edges] : _adjacency_list)
+        {
+            (void) vertex;
+            if (!edges.shared() && edges.capacity() < _expected_degree)
+            {
+                edges.mutate().reserve(_expected_degree);
+            }
+        }
+    }
+
+    // releases the capacity that isn't used, e.g. after the removals or once the graph is complete
+    // lists and the index shared with the snapshots are left alone, the hint of reserve_edges is dropped
+    void shrink_to_fit()
+    {
+        _adjacency_list.shrink_to_fit();
+        for (auto & [vertex, edges] : _adjacency_list)
+        {
+            (void) vertex;
+            edges.shrink_to_fit();
+        }
+        if (_vertex_index && _vertex_index.use_count() == 1)
+        {
+            _vertex_index->rehash(0);
+        }
+        for (auto const * columns : {&_vertex_columns, &_edge_columns})
+        {
+            for (auto const & column : *columns)
+            {
+                if (column.use_count() == 1)
+                {
+                    column->shrink_to_fit();
+                }
+            }
+        }
+        _expected_degree = 0;
+    }
+
+    // returns the bytes used and allocated by the parts of the graph
+    [[nodiscard]] auto memory_usage() const noexcept
+        -> graph_memory_usage
+    {
+        graph_memory_usage usage{};
+
+        usage.vertices = {_adjacency_list.size()     * sizeof(typename storage_type::value_type),
+                          _adjacency_list.capacity() * sizeof(typename storage_type::value_type)};
+
+        // make_shared puts the vector and the two reference counts into one allocation
+        auto const block_overhead = sizeof(edges_vector_type) + 2 * sizeof(void *);
+        for (auto const & [vertex, edges] : _adjacency_list)
+        {
+            (void) vertex;
+            if (edges.block() != nullptr)
+            {
+                usage.neighbors.used      += block_overhead + edges.size()     * sizeof(node_type);
+                usage.neighbors.allocated += block_overhead + edges.capacity() * sizeof(node_type);
+            }
+        }
+
+        if (_vertex_index)
+        {
+            // every node holds the next pointer, the element and the cached hash, every bucket is one pointer
+            auto const node = sizeof(void *) + sizeof(typename vertex_index_type::value_type) + sizeof(std::size_t);
+            usage.index.used      = _vertex_index->size() * node;
+            usage.index.allocated = usage.index.used + _vertex_index->bucket_count() * sizeof(void *);
+        }
+
+        for (auto const * columns : {&_vertex_columns, &_edge_columns})
+        {
+            for (auto const & column : *columns)
+            {
+                usage.properties.used      += column->used_bytes();
+                usage.properties.allocated += column->allocated_bytes();
+            }
+        }
+
+        return usage;
     }
 
     // inserts new vertex into the graph
@@ -197,7 +599,109 @@ public:
     {
         auto const it = assert_has_vertex(vertex, false);
 
-        _adjacency_list.emplace(it, std::pair{ node_type{std::forward<V>(vertex)}, std::vector<node_type>{}} );
+        _adjacency_list.emplace(it, node_type{std::forward<V>(vertex)}, edges_block_type{} );
+        mutable_vertex_index().emplace(_adjacency_list.back().first, _adjacency_list.size() - 1);
+        update_columns([](auto & column){ column.on_insert_vertex(); });
+        ++_version;
+    }
+
+    // adds the vertex property column, every vertex starts with the default value
+    // the returned handle is valid for this graph and for its copies
+    template <typename T>
+    auto add_vertex_property(T default_value = T{})
+        -> vertex_property<T>
+    {
+        _vertex_columns.emplace_back(std::make_shared<detail::vertex_column<T>>(num_vertices(), std::move(default_value)));
+        return vertex_property<T>{_vertex_columns.size() - 1};
+    }
+
+    // adds the edge property column, every edge starts with the default value
+    template <typename T>
+    auto add_edge_property(T default_value = T{})
+        -> edge_property<T>
+    {
+        std::vector<std::size_t> degrees{};
+        degrees.reserve(num_vertices());
+        for (auto const & [vertex, edges] : _adjacency_list)
+        {
+            (void) vertex;
+            degrees.emplace_back(edges.size());
+        }
+
+        _edge_columns.emplace_back(std::make_shared<detail::edge_column<T>>(degrees, std::move(default_value)));
+        return edge_property<T>{_edge_columns.size() - 1};
+    }
+
+    // returns the values of the vertex property, indexed by the slot of the vertex
+    template <typename T>
+    [[nodiscard]] auto vertex_values(vertex_property<T> property) const
+        -> std::vector<T> const &
+    {
+        return column_of(property).values;
+    }
+
+    // returns the values of the vertex property for the modification, the column is copied first if it is
+    // shared with some copy of the graph, values can be changed but the vector must not be resized
+    template <typename T>
+    [[nodiscard]] auto mutable_vertex_values(vertex_property<T> property)
+        -> std::vector<T> &
+    {
+        assert(property.column < _vertex_columns.size());
+        return static_cast<detail::vertex_column<T> &>(mutable_column(_vertex_columns[property.column])).values;
+    }
+
+    // returns the value of the vertex property for the vertex
+    // asserts whether the graph contains that vertex
+    template <typename T>
+    [[nodiscard]] auto vertex_value(vertex_property<T> property, V const & vertex) const
+        -> T const &
+    {
+        return vertex_values(property)[vertex_slot(assert_has_vertex(vertex, true))];
+    }
+
+    // sets the value of the vertex property for the vertex
+    // asserts whether the graph contains that vertex
+    template <typename T>
+    void set_vertex_value(vertex_property<T> property, V const & vertex, T value)
+    {
+        auto const slot = vertex_slot(assert_has_vertex(vertex, true));
+        mutable_vertex_values(property)[slot] = std::move(value);
+    }
+
+    // returns the values of the edge property for the edges of the vertex, in the order of adjacent_vertices(vertex)
+    // asserts whether the graph contains that vertex
+    template <typename T>
+    [[nodiscard]] auto edge_values(edge_property<T> property, V const & vertex) const
+        -> std::vector<T> const &
+    {
+        return column_of(property).lists[vertex_slot(assert_has_vertex(vertex, true))].get();
+    }
+
+    // returns the value of the edge property for the edge (first, second)
+    // asserts whether the graph contains the edge
+    template <typename T>
+    [[nodiscard]] auto edge_value(edge_property<T> property, V const & first, V const & second) const
+        -> T const &
+    {
+        auto const [slot, position] = edge_position(first, second);
+        return column_of(property).lists[slot][position];
+    }
+
+    // sets the value of the edge property for the edge (first, second), for the undirected graph on both ends
+    // asserts whether the graph contains the edge
+    template <typename T>
+    void set_edge_value(edge_property<T> property, V const & first, V const & second, T value)
+    {
+        assert(property.column < _edge_columns.size());
+        auto & column = static_cast<detail::edge_column<T> &>(mutable_column(_edge_columns[property.column]));
+
+        if constexpr (undirected == true)
+        {
+            auto const [slot, position] = edge_position(second, first);
+            column.lists[slot].mutate()[position] = value;
+        }
+        auto const [slot, position] = edge_position(first, second);
+        column.lists[slot].mutate()[position] = std::move(value);
     }
 
     // removes the vertex and all of its edges from the graph
@@ -209,24 +713,53 @@ public:
         // create a temporary to use inside the algorithm (in case that the V != node_type)
         // to make sure that no implicit temporaries are created
         node_type temp{vertex};
+        vertices_size_type list_slot{};
 
         for( auto & [vert, edges] : _adjacency_list)
         {
-            if(vert == vertex)
+            // lists that don't contain the vertex are left alone, so they stay shared with the snapshots
+            if(vert == vertex || std::find(std::cbegin(edges), std::cend(edges), temp) == std::cend(edges))
             {
+                ++list_slot;
                 continue;
             }
 
-            auto original_end = std::end(edges);
-            auto end_after_remove = std::remove( std::begin(edges),
+            // positions are reported from the back, so the earlier positions stay valid
+            for (auto position = edges.size(); !_edge_columns.empty() && position-- > 0; )
+            {
+                if (edges[position] == temp)
+                {
+                    update_edge_columns([&](auto & column){ column.on_remove_edge(list_slot, position); });
+                }
+            }
+            ++list_slot;
+
+            auto & mutable_edges = edges.mutate();
+            auto original_end = std::end(mutable_edges);
+            auto end_after_remove = std::remove( std::begin(mutable_edges),
                                                  original_end,
                                                  temp);
             _number_of_edges -= static_cast<edges_size_type>
                                     (std::abs(std::distance(end_after_remove, original_end)));
 
-            edges.erase(end_after_remove, original_end);
+            mutable_edges.erase(end_after_remove, original_end);
+        }
+
+        // vertices after the removed one move one slot to the front
+        auto const slot = vertex_slot(it);
+        update_columns([slot](auto & column){ column.on_remove_vertex(slot); });
+        auto & index = mutable_vertex_index();
+        index.erase(it->first);
+        for (auto & [vert, position] : index)
+        {
+            (void) vert;
+            if (position > slot)
+            {
+                --position;
+            }
         }
         _adjacency_list.erase(it);
+        ++_version;
     }
 
     // insert edge in the graph
@@ -241,6 +774,7 @@ public:
         {
             insert_edge_directed(first, second);
         }
+        ++_version;
     }
 
     // removes the edge from the graph
@@ -255,17 +789,44 @@ public:
         {
             remove_edge_directed(first,second);
         }
-        
+        ++_version;
+    }
+
+    // applies the net effect of the recorded operations in one pass over the storage
+    // returns false if some operation isn't valid for the graph, the graph is left untouched then
+    bool apply(mutation_batch<V,undirected> const & batch)
+    {
+        if (!batch.consistent() || !satisfies(batch))
+        {
+            return false;
+        }
+        if (batch.empty())
+        {
+            return true;
+        }
+
+        remove_vertices(batch);
+        insert_vertices(batch);
+        change_edges(batch);
+        ++_version;
+        return true;
     }
 
-    //TODO: see if this needs to be implemented
     void sort_vertices_by_degree()
     {
-        std::sort(std::begin(_adjacency_list), std::end(_adjacency_list),
-                [](auto const & first, auto const & second)
+        // the order of the slots is sorted, so the property columns can follow the vertices
+        std::vector<std::size_t> order(_adjacency_list.size());
+        std::iota(std::begin(order), std::end(order), std::size_t{});
+        std::sort(std::begin(order), std::end(order),
+                [this](auto const first, auto const second)
                 {
-                    return std::size(first.second) < std::size(second.second);
+                    return std::size(_adjacency_list[first].second) < std::size(_adjacency_list[second].second);
                 });
+
+        detail::reorder(_adjacency_list, order);
+        update_columns([&order](auto & column){ column.on_reorder(order); });
+        rebuild_vertex_index();
+        ++_version;
     }
 
     // checks whether the two vertices are adjacent
@@ -300,10 +861,9 @@ private:
     // if flag == true asserts that vertex exists
     // if flag == flase asserts that vertex doesn't exist
     [[nodiscard]] auto assert_has_vertex(V const & vertex, bool flag) const
-        -> typename graph_vector_type::const_iterator
+        -> typename storage_type::const_iterator
     {
-        auto const it = std::find_if(std::cbegin(_adjacency_list), std::cend(_adjacency_list),
-                                              [&](auto const & i){ return i.first == node_type{vertex};});
+        auto const it = std::next(std::cbegin(_adjacency_list), find_slot(vertex));
         assert((it == std::cend(_adjacency_list)) != flag);
 
         return it;
@@ -313,20 +873,342 @@ private:
     // if flag == true asserts that vertex exists
     // if flag == flase asserts that vertex doesn't exist
     [[nodiscard]] auto assert_has_vertex(V const & vertex, bool flag)
-        -> typename graph_vector_type::iterator
+        -> typename storage_type::iterator
     {
-        auto it = std::find_if(std::begin(_adjacency_list), std::end(_adjacency_list),
-                                              [&](auto const & i){ return i.first == node_type{vertex};});
+        auto it = std::next(std::begin(_adjacency_list), find_slot(vertex));
         assert((it == std::end(_adjacency_list)) != flag);
 
         return it;
     }
 
+    // returns the position of the vertex in the adjacency list, or num_vertices() if there is no such vertex
+    [[nodiscard]] auto find_slot(V const & vertex) const
+        -> typename storage_type::difference_type
+    {
+        auto const & index = vertex_index();
+        auto const found = index.find(node_type{vertex});
+
+        return static_cast<typename storage_type::difference_type>
+                    (found == std::cend(index) ? _adjacency_list.size() : found->second);
+    }
+
+    [[nodiscard]] auto vertex_slot(typename storage_type::const_iterator const & it) const noexcept
+        -> vertices_size_type
+    {
+        return static_cast<vertices_size_type>(std::distance(std::cbegin(_adjacency_list), it));
+    }
+
+    // returns the index that is owned only by this graph, so it can be safely modified
+    [[nodiscard]] auto mutable_vertex_index()
+        -> vertex_index_type &
+    {
+        if (!_vertex_index)
+        {
+            _vertex_index = std::make_shared<vertex_index_type>();
+        }
+        else if (_vertex_index.use_count() > 1)
+        {
+            _vertex_index = std::make_shared<vertex_index_type>(*_vertex_index);
+        }
+        return *_vertex_index;
+    }
+
+    // indexes the vertices from scratch, when the vertex appears more than once the first one is kept
+    void rebuild_vertex_index()
+    {
+        auto index = std::make_shared<vertex_index_type>();
+        index->reserve(_adjacency_list.size());
+        for (vertices_size_type slot = 0; slot < _adjacency_list.size(); ++slot)
+        {
+            index->emplace(_adjacency_list[slot].first, slot);
+        }
+        _vertex_index = std::move(index);
+    }
+
+    // clears the flag of every query (source, target) where the list of the source doesn't contain the target
+    // queries are grouped by the source, so every list is read only once and the next lists are prefetched
+    // big groups look the targets up in the sorted copy of the list, small ones just scan it
+    void keep_contained(std::vector<std::pair<vertices_size_type, vertices_size_type>> const & queries,
+                        std::vector<char> & flags) const
+    {
+        std::vector<std::size_t> order{};
+        order.reserve(queries.size());
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            if (flags[i])
+            {
+                order.emplace_back(i);
+            }
+        }
+        std::sort(std::begin(order), std::end(order),
+                  [&](auto first, auto second){ return queries[first].first < queries[second].first; });
+
+        std::vector<std::size_t> groups{};
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            if (i == 0 || queries[order[i]].first != queries[order[i - 1]].first)
+            {
+                groups.emplace_back(i);
+            }
+        }
+        groups.emplace_back(order.size());
+
+        std::vector<vertices_size_type> sorted{};
+        for (std::size_t group = 0; group + 1 < groups.size(); ++group)
+        {
+            // the block of the list two groups ahead and the elements of the list one group ahead
+            if (group + 3 < groups.size())
+            {
+                detail::prefetch(_adjacency_list[queries[order[groups[group + 2]]].first].second.block());
+            }
+            if (group + 2 < groups.size())
+            {
+                detail::prefetch(_adjacency_list[queries[order[groups[group + 1]]].first].second.get().data());
+            }
+
+            auto const begin = groups[group];
+            auto const end   = groups[group + 1];
+            auto const & edges = _adjacency_list[queries[order[begin]].first].second.get();
+
+            if (end - begin < scan_threshold || edges.size() < 2 * scan_threshold)
+            {
+                for (auto i = begin; i < end; ++i)
+                {
+                    auto const & target = _adjacency_list[queries[order[i]].second].first;
+                    flags[order[i]] = std::find(std::cbegin(edges), std::cend(edges), target) != std::cend(edges);
+                }
+                continue;
+            }
+
+            auto const & index = vertex_index();
+            sorted.clear();
+            for (auto const & neighbor : edges)
+            {
+                auto const found = index.find(neighbor);
+                if (found != std::cend(index))
+                {
+                    sorted.emplace_back(found->second);
+                }
+            }
+            std::sort(std::begin(sorted), std::end(sorted));
+
+            for (auto i = begin; i < end; ++i)
+            {
+                flags[order[i]] = std::binary_search(std::cbegin(sorted), std::cend(sorted), queries[order[i]].second);
+            }
+        }
+    }
+
+    // checks whether the graph has the vertices and the edges the batch expects it to have
+    [[nodiscard]] bool satisfies(mutation_batch<V,undirected> const & batch) const
+    {
+        auto const & index = vertex_index();
+        for (auto const & [vertex, change] : batch._vertices)
+        {
+            if ((index.find(vertex) != std::cend(index)) != change.existed)
+            {
+                return false;
+            }
+        }
+        for (auto const & change : batch._edges)
+        {
+            // the ends of the original edge are the vertices of the graph, they were checked above
+            if (change.original)
+            {
+                auto const & edges = _adjacency_list[index.find(change.first)->second].second;
+                if ((std::find(std::cbegin(edges), std::cend(edges), change.second) != std::cend(edges)) != change.existed)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // drops the removed vertices from the lists of their neighbors, then compacts the storage once
+    void remove_vertices(mutation_batch<V,undirected> const & batch)
+    {
+        auto const & index = vertex_index();
+        std::vector<char> removed(_adjacency_list.size());
+        bool any{};
+        for (auto const & [vertex, change] : batch._vertices)
+        {
+            if (change.existed && change.generation > 0)
+            {
+                removed[index.find(vertex)->second] = 1;
+                any = true;
+            }
+        }
+        if (!any)
+        {
+            return;
+        }
+
+        // only the neighbors of the undirected vertex have it in their lists
+        std::vector<char> affected(_adjacency_list.size(), undirected ? char{0} : char{1});
+        edges_size_type ends{};
+        for (vertices_size_type slot = 0; slot < _adjacency_list.size(); ++slot)
+        {
+            if (removed[slot])
+            {
+                ends += _adjacency_list[slot].second.size();
+                for (auto const & neighbor : _adjacency_list[slot].second)
+                {
+                    affected[index.find(neighbor)->second] = 1;
+                }
+            }
+        }
+
+        auto const gone = [&](node_type const & neighbor){ return removed[index.find(neighbor)->second] != 0; };
+        for (vertices_size_type slot = 0; slot < _adjacency_list.size(); ++slot)
+        {
+            auto & edges = _adjacency_list[slot].second;
+            // lists that don't contain the removed vertices are left alone, so they stay shared with the snapshots
+            if (removed[slot] || !affected[slot] || std::none_of(std::cbegin(edges), std::cend(edges), gone))
+            {
+                continue;
+            }
+
+            // positions are reported from the back, so the earlier positions stay valid
+            for (auto position = edges.size(); !_edge_columns.empty() && position-- > 0; )
+            {
+                if (gone(edges[position]))
+                {
+                    update_edge_columns([&](auto & column){ column.on_remove_edge(slot, position); });
+                }
+            }
+
+            auto & mutable_edges = edges.mutate();
+            auto const end_after_remove = std::remove_if(std::begin(mutable_edges), std::end(mutable_edges), gone);
+            ends += static_cast<edges_size_type>(std::distance(end_after_remove, std::end(mutable_edges)));
+            mutable_edges.erase(end_after_remove, std::end(mutable_edges));
+        }
+        _number_of_edges -= undirected ? ends / 2 : ends;
+
+        // the kept vertices keep their order, the columns are compacted the same way
+        std::vector<std::size_t> order{};
+        order.reserve(_adjacency_list.size());
+        for (vertices_size_type slot = 0; slot < _adjacency_list.size(); ++slot)
+        {
+            if (!removed[slot])
+            {
+                order.emplace_back(slot);
+            }
+        }
+        detail::reorder(_adjacency_list, order);
+        update_columns([&order](auto & column){ column.on_reorder(order); });
+        rebuild_vertex_index();
+    }
+
+    // appends the inserted vertices in the order they were inserted, including the removed and inserted again
+    void insert_vertices(mutation_batch<V,undirected> const & batch)
+    {
+        std::vector<std::pair<std::size_t, node_type const *>> inserted{};
+        for (auto const & [vertex, change] : batch._vertices)
+        {
+            if (change.exists && (!change.existed || change.generation > 0))
+            {
+                inserted.emplace_back(change.inserted, &vertex);
+            }
+        }
+        std::sort(std::begin(inserted), std::end(inserted),
+                  [](auto const & first, auto const & second){ return first.first < second.first; });
+
+        _adjacency_list.reserve(_adjacency_list.size() + inserted.size());
+        auto & index = mutable_vertex_index();
+        for (auto const & [order, vertex] : inserted)
+        {
+            (void) order;
+            _adjacency_list.emplace_back(*vertex, edges_block_type{});
+            index.emplace(*vertex, _adjacency_list.size() - 1);
+            update_columns([](auto & column){ column.on_insert_vertex(); });
+        }
+    }
+
+    // changes every neighbor list at most once, the removed neighbors are filtered out in one pass
+    void change_edges(mutation_batch<V,undirected> const & batch)
+    {
+        struct list_change
+        {
+            vertices_size_type slot;
+            vertices_size_type neighbor;
+            bool               insert;
+        };
+
+        auto const & index = vertex_index();
+        std::vector<list_change> changes{};
+        for (auto const & change : batch._edges)
+        {
+            if (change.existed == change.exists || !batch.live(change))
+            {
+                continue;
+            }
+            auto const first  = index.find(change.first)->second;
+            auto const second = index.find(change.second)->second;
+            changes.emplace_back(list_change{first, second, change.exists});
+            if constexpr (undirected == true)
+            {
+                changes.emplace_back(list_change{second, first, change.exists});
+            }
+            _number_of_edges = change.exists ? _number_of_edges + 1 : _number_of_edges - 1;
+        }
+        // the inserted neighbors of the same list stay in the order they were recorded
+        std::stable_sort(std::begin(changes), std::end(changes),
+                         [](auto const & first, auto const & second){ return first.slot < second.slot; });
+
+        std::vector<vertices_size_type> removed{};
+        for (std::size_t begin = 0; begin < changes.size(); )
+        {
+            auto const slot = changes[begin].slot;
+            auto end = begin;
+            removed.clear();
+            for (; end < changes.size() && changes[end].slot == slot; ++end)
+            {
+                if (!changes[end].insert)
+                {
+                    removed.emplace_back(changes[end].neighbor);
+                }
+            }
+
+            auto & edges = _adjacency_list[slot].second;
+            if (!removed.empty())
+            {
+                std::sort(std::begin(removed), std::end(removed));
+                auto const gone = [&](node_type const & neighbor)
+                {
+                    return std::binary_search(std::cbegin(removed), std::cend(removed), index.find(neighbor)->second);
+                };
+
+                for (auto position = edges.size(); !_edge_columns.empty() && position-- > 0; )
+                {
+                    if (gone(edges[position]))
+                    {
+                        update_edge_columns([&](auto & column){ column.on_remove_edge(slot, position); });
+                    }
+                }
+
+                auto & mutable_edges = edges.mutate();
+                mutable_edges.erase(std::remove_if(std::begin(mutable_edges), std::end(mutable_edges), gone),
+                                    std::end(mutable_edges));
+            }
+
+            for (auto i = begin; i < end; ++i)
+            {
+                if (changes[i].insert)
+                {
+                    append_neighbor(edges, _adjacency_list[changes[i].neighbor].first);
+                    update_edge_columns([slot](auto & column){ column.on_insert_edge(slot); });
+                }
+            }
+            begin = end;
+        }
+    }
+
     // given the bool flag asserts whether the edge exists or doesn't exist in the graph
     // if flag == true asserts that edge exists
     // if flag == flase asserts that edge doesn't exist
-    void assert_has_edge(typename graph_vector_type::iterator const & node_a,
-                         typename graph_vector_type::iterator const & node_b, 
+    void assert_has_edge(typename storage_type::iterator const & node_a,
+                         typename storage_type::iterator const & node_b, 
                          bool flag) const
     {
         auto const it = std::find(std::cbegin(node_a->second), std::cend(node_a->second),
@@ -338,8 +1220,8 @@ private:
     // given the bool flag asserts whether the edge exists or doesn't exist in the graph
     // if flag == true asserts that edge exists
     // if flag == flase asserts that edge doesn't exist
-    void assert_has_edge(typename graph_vector_type::const_iterator const & node_a,
-                         typename graph_vector_type::const_iterator const & node_b,
+    void assert_has_edge(typename storage_type::const_iterator const & node_a,
+                         typename storage_type::const_iterator const & node_b,
                          bool flag) const
     {
         auto const it = std::find(std::cbegin(node_a->second), std::cend(node_a->second),
@@ -348,6 +1230,81 @@ private:
         assert((it == std::cend(node_a->second)) != flag);
     }
 
+    // calls fn on every vertex and edge column, the shared columns are copied first
+    template <typename F>
+    void update_columns(F && fn)
+    {
+        for (auto * columns : {&_vertex_columns, &_edge_columns})
+        {
+            for (auto & column : *columns)
+            {
+                fn(mutable_column(column));
+            }
+        }
+    }
+
+    // same as above, only for the edge columns
+    template <typename F>
+    void update_edge_columns(F && fn)
+    {
+        for (auto & column : _edge_columns)
+        {
+            fn(mutable_column(column));
+        }
+    }
+
+    // returns the column that is owned only by this graph, so it can be safely modified
+    [[nodiscard]] static auto mutable_column(std::shared_ptr<detail::property_column> & column)
+        -> detail::property_column &
+    {
+        if (column.use_count() > 1)
+        {
+            column = column->clone();
+        }
+        return *column;
+    }
+
+    template <typename T>
+    [[nodiscard]] auto column_of(vertex_property<T> property) const
+        -> detail::vertex_column<T> const &
+    {
+        assert(property.column < _vertex_columns.size());
+        return static_cast<detail::vertex_column<T> const &>(*_vertex_columns[property.column]);
+    }
+
+    template <typename T>
+    [[nodiscard]] auto column_of(edge_property<T> property) const
+        -> detail::edge_column<T> const &
+    {
+        assert(property.column < _edge_columns.size());
+        return static_cast<detail::edge_column<T> const &>(*_edge_columns[property.column]);
+    }
+
+    // returns the slot of the first vertex and the position of the second one in its list
+    // asserts whether the graph contains the edge
+    [[nodiscard]] auto edge_position(V const & first, V const & second) const
+        -> std::pair<vertices_size_type, edges_size_type>
+    {
+        auto const first_it  = assert_has_vertex(first, true);
+        auto const second_it = assert_has_vertex(second, true);
+        auto const & edges = first_it->second;
+        auto const it = std::find(std::cbegin(edges), std::cend(edges), second_it->first);
+        assert(it != std::cend(edges));
+
+        return {vertex_slot(first_it), static_cast<edges_size_type>(std::distance(std::cbegin(edges), it))};
+    }
+
+    // appends the neighbor to the list, the new list first gets the room for the expected degree
+    void append_neighbor(edges_block_type & edges, V const & neighbor)
+    {
+        auto & mutable_edges = edges.mutate();
+        if (mutable_edges.capacity() == 0)
+        {
+            mutable_edges.reserve(_expected_degree);
+        }
+        mutable_edges.emplace_back(neighbor);
+    }
+
     // insert edge into the directed graph
     // first assert that the vertices exist and the edge doesn't exist
     // only inserts edge node_a -> node_b
@@ -358,7 +1315,8 @@ private:
 
         assert_has_edge(first_it, second_it, false);
 
-        first_it->second.emplace_back(node_b);
+        append_neighbor(first_it->second, node_b);
+        update_edge_columns([slot = vertex_slot(first_it)](auto & column){ column.on_insert_edge(slot); });
 
         ++_number_of_edges;
 
@@ -375,8 +1333,13 @@ private:
         assert_has_edge(first_it, second_it, false);
         assert_has_edge(second_it, first_it, false);
 
-        first_it->second.emplace_back(node_b);
-        second_it->second.emplace_back(node_a);
+        append_neighbor(first_it->second, node_b);
+        append_neighbor(second_it->second, node_a);
+        update_edge_columns([first = vertex_slot(first_it), second = vertex_slot(second_it)](auto & column)
+        {
+            column.on_insert_edge(first);
+            column.on_insert_edge(second);
+        });
 
         ++_number_of_edges;
     }
@@ -390,16 +1353,30 @@ private:
 
         assert_has_edge(first_it, second_it, true);
         assert_has_edge(second_it, first_it, true);
+
+        if (!_edge_columns.empty())
+        {
+            auto const [first_slot, first_position]   = edge_position(node_a, node_b);
+            auto const [second_slot, second_position] = edge_position(node_b, node_a);
+            update_edge_columns([&](auto & column)
+            {
+                column.on_remove_edge(first_slot, first_position);
+                column.on_remove_edge(second_slot, second_position);
+            });
+        }
         
-        first_it->second.erase( std::remove( std::begin(first_it->second),
-                                            std::end(first_it->second), 
-                                            second_it->first ), 
-                                            std::end(first_it->second) );
+        auto & first_edges  = first_it->second.mutate();
+        auto & second_edges = second_it->second.mutate();
+
+        first_edges.erase( std::remove( std::begin(first_edges),
+                                        std::end(first_edges), 
+                                        second_it->first ), 
+                                        std::end(first_edges) );
         
-        second_it->second.erase( std::remove( std::begin(second_it->second),
-                                             std::end(second_it->second), 
-                                             first_it->first ), 
-                                             std::end(second_it->second) );
+        second_edges.erase( std::remove( std::begin(second_edges),
+                                         std::end(second_edges), 
+                                         first_it->first ), 
+                                         std::end(second_edges) );
         --_number_of_edges;
     }
 
@@ -411,11 +1388,19 @@ private:
         auto second_it = assert_has_vertex(node_b, true);
 
         assert_has_edge(first_it, second_it, true);
+
+        if (!_edge_columns.empty())
+        {
+            auto const [slot, position] = edge_position(node_a, node_b);
+            update_edge_columns([&](auto & column){ column.on_remove_edge(slot, position); });
+        }
         
-        first_it->second.erase( std::remove( std::begin(first_it->second),
-                                            std::end(first_it->second), 
-                                            second_it->first ), 
-                                            std::end(first_it->second) );
+        auto & first_edges = first_it->second.mutate();
+
+        first_edges.erase( std::remove( std::begin(first_edges),
+                                        std::end(first_edges), 
+                                        second_it->first ), 
+                                        std::end(first_edges) );
         
         --_number_of_edges;
     }
@@ -1,7 +1,15 @@
+#pragma once
 #include "graph_lib_base.hpp"
 #include "graph.hpp"
+#include "graph_lib_detail.hpp"
+#include "subgraph_view.hpp"
 #include <utility>
 #include <tuple>
+#include <atomic>
+#include <ostream>
+#include <algorithm>
+#include <numeric>
+#include <random>
 
 
 /*
@@ -44,6 +52,76 @@ auto graph_lib::find_all_connected_vertices_of_the_same_degree(graph_lib::graph<
     return ret_val;
 }
 
+// same as above, with the policy the vertices are split into chunks that are matched in parallel
+// every chunk first counts its edges and then writes them from its own offset, so the order is the same
+template <typename ExecutionPolicy, typename V, bool undirected>
+auto graph_lib::find_all_connected_vertices_of_the_same_degree(ExecutionPolicy &&, graph_lib::graph<V,undirected> const & g,
+                                                               typename graph_lib::graph<V,undirected>::edges_size_type const & degree)
+    -> std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, std::vector<std::pair<V,V>>>
+{
+    if constexpr (!execution::is_parallel_policy_v<ExecutionPolicy>)
+    {
+        return find_all_connected_vertices_of_the_same_degree(g, degree);
+    }
+    else
+    {
+        auto const matching = [&](std::size_t slot, auto emit)
+        {
+            auto const & [vertex, edges] = *std::next(g.cbegin(), static_cast<std::ptrdiff_t>(slot));
+            if (std::size(edges) == degree)
+            {
+                for (auto const & adjacent_vertex : edges)
+                {
+                    if (g.degree(adjacent_vertex) == degree)
+                    {
+                        emit(vertex, adjacent_vertex);
+                    }
+                }
+            }
+        };
+
+        return detail::parallel_emit<std::pair<V,V>>(g.num_vertices(),
+            [&](std::size_t slot)
+            {
+                std::size_t count{};
+                matching(slot, [&](auto const &, auto const &){ ++count; });
+                return count;
+            },
+            [&](std::size_t slot, auto out)
+            {
+                matching(slot, [&](auto const & vertex, auto const & adjacent_vertex){ *out++ = std::pair{vertex, adjacent_vertex}; });
+                return out;
+            }, 1024);
+    }
+}
+
+// same as above on the induced subgraph, degrees are the degrees inside the subgraph
+// the degrees are read from the compact adjacency, so every list of the graph is filtered only once
+template <typename V, bool undirected>
+auto graph_lib::find_all_connected_vertices_of_the_same_degree(induced_subgraph<V,undirected> const & g,
+                                                               typename graph_lib::graph<V,undirected>::edges_size_type const & degree)
+    -> typename std::vector<std::pair<V,V>>
+{
+    auto const adjacency = detail::make_compact_adjacency(g);
+    auto const vertices  = detail::make_vertex_pointers(g);
+
+    std::vector<std::pair<V,V>> ret_val{};
+    for (std::size_t u = 0; u < adjacency.num_vertices(); ++u)
+    {
+        if (adjacency.degree(u) == degree)
+        {
+            for (auto e = adjacency.offsets[u]; e < adjacency.offsets[u + 1]; ++e)
+            {
+                if (adjacency.degree(adjacency.targets[e]) == degree)
+                {
+                    ret_val.emplace_back(std::pair{*vertices[u], *vertices[adjacency.targets[e]]});
+                }
+            }
+        }
+    }
+    return ret_val;
+}
+
 /*
 Pseudo code for the triangular face finding algorithm
 
@@ -67,26 +145,104 @@ auto graph_lib::find_triangular_faces(graph_lib::graph<V,undirected> const & g)
         -> typename std::vector<std::tuple<V,V,V>>
 {
     std::vector<std::tuple<V,V,V>> ret_val{};
-    graph_lib::graph<V, undirected> temp{g};
 
-    for (auto & [u, edges] : temp)
+    for_each_triangular_face(g, [&](auto const & u, auto const & v, auto const & w)
+    {
+        ret_val.emplace_back(std::tuple{u, v, w});
+    });
+
+    return ret_val;
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_triangular_faces(induced_subgraph<V,undirected> const & g)
+        -> typename std::vector<std::tuple<V,V,V>>
+{
+    std::vector<std::tuple<V,V,V>> ret_val{};
+
+    for_each_triangular_face(g, [&](auto const & u, auto const & v, auto const & w)
+    {
+        ret_val.emplace_back(std::tuple{u, v, w});
+    });
+
+    return ret_val;
+}
+
+namespace graph_lib::detail
+{
+    // the algorithm above on the compact adjacency of G, which works for the graph and for the view alike
+    // the copy of G is the copy of the targets, every list keeps its remaining neighbors at its front in the
+    // original order and remove_edge shifts the rest of the list, so the triples come in the same order
+    // as removing the edges from the snapshot of G
+    template <bool undirected, typename G, typename F>
+    void for_each_triangular_face(G const & g, F && fn)
     {
-        for (size_t i = 0; i< std::size(edges); ++i)
+        auto const adjacency = make_compact_adjacency(g);
+        auto const vertices  = make_vertex_pointers(g);
+
+        auto temp = adjacency.targets;
+        std::vector<std::size_t> remaining(adjacency.num_vertices());
+        for (std::size_t u = 0; u < remaining.size(); ++u)
         {
-            auto v = edges.at(i);
+            remaining[u] = adjacency.degree(u);
+        }
 
-            for (auto & w : g.adjacent_vertices(u))
+        auto const list = [&](std::size_t u)
+        {
+            auto const first = std::next(std::begin(temp), static_cast<std::ptrdiff_t>(adjacency.offsets[u]));
+            return std::pair{first, std::next(first, static_cast<std::ptrdiff_t>(remaining[u]))};
+        };
+        auto const are_adjacent = [&](std::size_t u, std::size_t v)
+        {
+            auto const [first, last] = list(u);
+            return std::find(first, last, v) != last;
+        };
+        auto const remove_edge = [&](std::size_t u, std::size_t v)
+        {
+            auto const [first, last] = list(u);
+            auto const it = std::find(first, last, v);
+            assert(it != last);
+            std::copy(std::next(it), last, it);
+            --remaining[u];
+        };
+
+        for (std::size_t u = 0; u < adjacency.num_vertices(); ++u)
+        {
+            for (std::size_t i = 0; i < remaining[u]; ++i)
             {
-                // since graph reprezents a polyhedron there will be no vertices connnected to themself
-                if(temp.are_adjacent(v,w))
+                auto const v = temp[adjacency.offsets[u] + i];
+
+                for (auto e = adjacency.offsets[u]; e < adjacency.offsets[u + 1]; ++e)
                 {
-                    ret_val.emplace_back(std::tuple{u, v, w});
+                    // since graph reprezents a polyhedron there will be no vertices connnected to themself
+                    auto const w = adjacency.targets[e];
+                    if (are_adjacent(v, w))
+                    {
+                        fn(*vertices[u], *vertices[v], *vertices[w]);
+                    }
+                }
+                remove_edge(u, v);
+                if constexpr (undirected == true)
+                {
+                    remove_edge(v, u);
                 }
             }
-            temp.remove_edge(u, v);
         }
     }
-    return ret_val;
+}
+
+// streaming version of find_triangular_faces, fn(u, v, w) is called for every triple in the same order
+// nothing is collected, so the triples can be consumed while they are found
+template <typename V, bool undirected, typename F>
+void graph_lib::for_each_triangular_face(graph_lib::graph<V,undirected> const & g, F && fn)
+{
+    detail::for_each_triangular_face<undirected>(g, std::forward<F>(fn));
+}
+
+template <typename V, bool undirected, typename F>
+void graph_lib::for_each_triangular_face(induced_subgraph<V,undirected> const & g, F && fn)
+{
+    detail::for_each_triangular_face<undirected>(g, std::forward<F>(fn));
 }
 
 /*
@@ -116,6 +272,38 @@ auto graph_lib::cone_triangulation(std::vector<std::tuple<V,V,V>> const & T, V q
     return ret_val;
 }
 
+// same as above, with the policy the triples are filtered in parallel chunks
+// every chunk first counts its tetrahedra and then writes them from its own offset, so the order is the same
+template <typename ExecutionPolicy, typename V>
+auto graph_lib::cone_triangulation(ExecutionPolicy &&, std::vector<std::tuple<V,V,V>> const & T, V q)
+        -> std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, std::vector<std::tuple<V,V,V,V>>>
+{
+    if constexpr (!execution::is_parallel_policy_v<ExecutionPolicy>)
+    {
+        return cone_triangulation(T, q);
+    }
+    else
+    {
+        auto const keep = [&](std::size_t i)
+        {
+            auto const & [u, v, w] = T[i];
+            return (u != q) && (v != q) && (w != q);
+        };
+
+        return detail::parallel_emit<std::tuple<V,V,V,V>>(std::size(T),
+            [&](std::size_t i) -> std::size_t { return keep(i) ? 1 : 0; },
+            [&](std::size_t i, auto out)
+            {
+                if (keep(i))
+                {
+                    auto const & [u, v, w] = T[i];
+                    *out++ = std::tuple{q, u, v, w};
+                }
+                return out;
+            });
+    }
+}
+
 template <typename V, bool undirected>
 std::ostream & operator<<(std::ostream & ost, graph_lib::graph<V,undirected> const & g)
 {
@@ -163,4 +351,484 @@ auto graph_lib::find_orders_of_vertices(graph<V,undirected> const & g)
                                                 {return first.second < secod.second;});
 
     return vec;
-}
\ No newline at end of file
+}
+
+// same as above, with the policy the degrees are read and sorted in parallel
+// the parallel sort is stable, so the vertices of the same degree keep the order from the graph
+template <typename ExecutionPolicy, typename V, bool undirected>
+auto graph_lib::find_orders_of_vertices(ExecutionPolicy &&, graph<V,undirected> const & g)
+    -> std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>,
+                        std::vector<std::pair<V, typename graph<V,undirected>::edges_size_type>>>
+{
+    if constexpr (!execution::is_parallel_policy_v<ExecutionPolicy>)
+    {
+        return find_orders_of_vertices(g);
+    }
+    else
+    {
+        std::vector<std::pair<V, typename graph<V,undirected>::edges_size_type>> vec(g.num_vertices());
+
+        detail::parallel_for(g.num_vertices(), [&](std::size_t begin, std::size_t end)
+        {
+            auto it = std::next(g.cbegin(), static_cast<std::ptrdiff_t>(begin));
+            for (auto slot = begin; slot < end; ++slot, ++it)
+            {
+                vec[slot] = std::pair{it->first, std::size(it->second)};
+            }
+        });
+
+        detail::parallel_sort(std::begin(vec), std::end(vec), [](auto const & first, auto const & second)
+                                                              {return first.second < second.second;});
+
+        return vec;
+    }
+}
+
+// same as above on the induced subgraph, degrees are the degrees inside the subgraph
+template <typename V, bool undirected>
+auto graph_lib::find_orders_of_vertices(induced_subgraph<V,undirected> const & g)
+    -> typename std::vector<std::pair<V, typename graph<V,undirected>::edges_size_type>>
+{
+    std::vector<std::pair<V, typename graph<V,undirected>::edges_size_type>> vec{};
+    vec.reserve(g.num_vertices());
+
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        vec.emplace_back(std::pair{it->first, std::size(it->second)});
+    }
+
+    std::sort(std::begin(vec), std::end(vec), [](auto const & first, auto const & second)
+                                                {return first.second < second.second;});
+
+    return vec;
+}
+
+/*
+Connected components with the concurrent union-find
+
+Every vertex starts as its own set, parent[v] = v;
+in parallel, for each range of edges in G.edges() {
+    for each edge (u,v) in the range
+        union(u,v); // link the root with the larger slot under the one with the smaller slot
+}
+in parallel, for each vertex v in G.vertices() {
+    root[v] = find(v);
+}
+Label the roots in the order they are first seen and count the vertices of every label;
+
+NOTE: union links with the compare and swap on the parent of the root, if some other thread has
+    linked that root in the meantime, the roots are looked up again and linking is retried.
+    Since the root is always linked under the root with the smaller slot, parents can only
+    decrease and no cycles can appear. find uses path halving, also done with compare and swap,
+    failed compression is harmless since the parent only ever moves closer to the root.
+    For directed graphs the weakly connected components are returned.
+*/
+
+template <typename V>
+struct graph_lib::connected_components
+{
+    // label of the component for every vertex, in the order of the vertices in the graph
+    std::vector<std::pair<V, std::size_t>> labels;
+    // number of vertices in every component, indexed by the label
+    std::vector<std::size_t> sizes;
+};
+
+namespace graph_lib::detail
+{
+    // works for the graph and for the view alike, only the compact adjacency and the vertices are read
+    template <typename V, typename G>
+    auto find_connected_components(G const & g)
+        -> connected_components<V>
+    {
+        auto const adjacency = detail::make_compact_adjacency(g);
+        auto const vertices  = adjacency.num_vertices();
+
+        std::vector<std::atomic<std::size_t>> parent(vertices);
+        detail::parallel_for(vertices, [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                parent[i].store(i, std::memory_order_relaxed);
+            }
+        });
+
+        auto const find = [&parent](std::size_t x)
+        {
+            while (true)
+            {
+                auto p = parent[x].load(std::memory_order_relaxed);
+                auto const grandparent = parent[p].load(std::memory_order_relaxed);
+                if (p == grandparent)
+                {
+                    return p;
+                }
+                parent[x].compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+                x = grandparent;
+            }
+        };
+
+        auto const unite = [&parent, &find](std::size_t a, std::size_t b)
+        {
+            while (true)
+            {
+                a = find(a);
+                b = find(b);
+                if (a == b)
+                {
+                    return;
+                }
+                if (a < b)
+                {
+                    std::swap(a, b);
+                }
+                auto expected = a;
+                if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed))
+                {
+                    return;
+                }
+            }
+        };
+
+        // every chunk is a contiguous range of the edge array, the source of the first edge
+        // is found with a binary search over the offsets
+        detail::parallel_for(std::size(adjacency.targets), [&](std::size_t begin, std::size_t end)
+        {
+            auto u = static_cast<std::size_t>(std::distance(std::cbegin(adjacency.offsets),
+                                                             std::upper_bound(std::cbegin(adjacency.offsets),
+                                                                              std::cend(adjacency.offsets),
+                                                                              begin))) - 1;
+            for (auto e = begin; e < end; ++e)
+            {
+                while (adjacency.offsets[u + 1] <= e)
+                {
+                    ++u;
+                }
+                unite(u, adjacency.targets[e]);
+            }
+        });
+
+        std::vector<std::size_t> roots(vertices);
+        detail::parallel_for(vertices, [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                roots[i] = find(i);
+            }
+        });
+
+        connected_components<V> ret_val{};
+        ret_val.labels.reserve(vertices);
+
+        // roots always have the smallest slot in their component, so the root is labeled
+        // before any other vertex of the component is reached
+        std::vector<std::size_t> label_of_root(vertices);
+        std::size_t slot{};
+        for (auto it = g.cbegin(); it != g.cend(); ++it, ++slot)
+        {
+            auto const root = roots[slot];
+            if (root == slot)
+            {
+                label_of_root[slot] = std::size(ret_val.sizes);
+                ret_val.sizes.emplace_back(0);
+            }
+            auto const label = label_of_root[root];
+            ++ret_val.sizes[label];
+            ret_val.labels.emplace_back(std::pair{it->first, label});
+        }
+
+        return ret_val;
+    }
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_connected_components(graph<V,undirected> const & g)
+    -> connected_components<V>
+{
+    return detail::find_connected_components<V>(g);
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_connected_components(induced_subgraph<V,undirected> const & g)
+    -> connected_components<V>
+{
+    return detail::find_connected_components<V>(g);
+}
+
+// a graph is connected if it has exactly one component, empty graph is not connected
+template <typename V, bool undirected>
+auto graph_lib::is_connected(graph<V,undirected> const & g)
+    -> bool
+{
+    return std::size(find_connected_components(g).sizes) == 1;
+}
+
+/*
+Core decomposition, k-core of G is the largest subgraph where every vertex has at least k neighbors
+
+Let every vertex be in the bucket of its degree;
+for d = 0, 1, 2, ... {
+    while the bucket d is not empty {
+        v = any vertex from the bucket d;
+        core(v) = d; L.insertLast(v); // remove v from G
+        for each remaining vertex u in G.adjacentVertices(v) with degree(u) > d
+            move u from its bucket to the bucket degree(u) - 1;
+    }
+}
+return core, L and the largest core as the degeneracy
+
+NOTE: every vertex has at most degeneracy neighbors after it in L, so the algorithms that go over the
+    vertices in the order L and only look forward do at most degeneracy work per vertex instead of
+    the maximal degree. Buckets are kept in one array (see detail::peel_cores), so it takes O(V+E).
+*/
+
+template <typename V>
+struct graph_lib::core_decomposition
+{
+    // core number of every vertex, in the order of the vertices in the graph
+    std::vector<std::pair<V, std::size_t>> core_numbers;
+    // vertices in the degeneracy ordering
+    std::vector<V> ordering;
+    // largest core number, 0 for the empty graph
+    std::size_t degeneracy;
+};
+
+namespace graph_lib::detail
+{
+    template <typename V, typename G>
+    auto find_core_decomposition(G const & g)
+        -> core_decomposition<V>
+    {
+        auto const peeling = detail::peel_cores(detail::make_compact_adjacency(g));
+
+        core_decomposition<V> ret_val{};
+        ret_val.degeneracy = peeling.degeneracy;
+        ret_val.core_numbers.reserve(g.num_vertices());
+        ret_val.ordering.reserve(g.num_vertices());
+
+        std::size_t slot{};
+        for (auto it = g.cbegin(); it != g.cend(); ++it, ++slot)
+        {
+            ret_val.core_numbers.emplace_back(std::pair{it->first, peeling.core[slot]});
+        }
+        for (auto const vertex_slot : peeling.order)
+        {
+            ret_val.ordering.emplace_back(ret_val.core_numbers[vertex_slot].first);
+        }
+
+        return ret_val;
+    }
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_core_decomposition(graph<V,undirected> const & g)
+    -> core_decomposition<V>
+{
+    static_assert(undirected == true, "graph has to be undirected");
+
+    return detail::find_core_decomposition<V>(g);
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_core_decomposition(induced_subgraph<V,undirected> const & g)
+    -> core_decomposition<V>
+{
+    static_assert(undirected == true, "graph has to be undirected");
+
+    return detail::find_core_decomposition<V>(g);
+}
+
+/*
+Vertex coloring (Jones, Plassmann), every vertex gets a priority from the chosen ordering
+
+for each vertex v in G.vertices() {
+    pending(v) = number of the neighbors of v with the higher priority;
+}
+R = the vertices with pending(v) == 0;
+while R is not empty {
+    in parallel, for each vertex v in R {
+        color(v) = the smallest color not used by the neighbors of v with the higher priority;
+        for each vertex u in G.adjacentVertices(v) with the lower priority
+            if (--pending(u) == 0) then
+                R'.insertLast(u);
+    }
+    R = R';
+}
+
+NOTE: vertex is colored only after all of its neighbors with the higher priority, so the colors are the same
+    as the ones of the serial greedy coloring in the order of the priorities, only the independent vertices
+    are colored at the same time. The smallest last ordering (reversed degeneracy ordering, see the core
+    decomposition) gives every vertex at most degeneracy neighbors with the higher priority, so at most
+    degeneracy + 1 colors are used, at most 6 for the planar graphs. The largest first and random orderings
+    use more colors, but the chains of the priorities are shorter, so there are fewer rounds.
+*/
+
+enum class graph_lib::coloring_order
+{
+    // reversed degeneracy ordering, the fewest colors
+    smallest_last,
+    // higher degree first, the ties are broken at random
+    largest_first,
+    // random priorities, the fewest rounds
+    random
+};
+
+template <typename V>
+struct graph_lib::vertex_coloring
+{
+    // color of every vertex, in the order of the vertices in the graph
+    std::vector<std::pair<V, std::size_t>> colors;
+    // vertices of every color, indexed by the color, no two vertices of the same class are adjacent
+    std::vector<std::vector<V>> classes;
+};
+
+namespace graph_lib::detail
+{
+    // priority of every vertex for the ordering, the vertex with the higher priority is colored first
+    inline auto coloring_priorities(compact_adjacency const & adjacency, coloring_order order)
+        -> std::vector<std::size_t>
+    {
+        auto const vertices = adjacency.num_vertices();
+        std::vector<std::size_t> ranked(vertices);
+
+        if (order == coloring_order::smallest_last)
+        {
+            // the vertex peeled last is colored first
+            ranked = peel_cores(adjacency).order;
+        }
+        else
+        {
+            // fixed seed, so the coloring is the same on every run
+            std::iota(std::begin(ranked), std::end(ranked), std::size_t{});
+            std::shuffle(std::begin(ranked), std::end(ranked), std::mt19937_64{vertices});
+            if (order == coloring_order::largest_first)
+            {
+                std::stable_sort(std::begin(ranked), std::end(ranked), [&](std::size_t first, std::size_t second)
+                                 { return adjacency.degree(first) < adjacency.degree(second); });
+            }
+        }
+
+        std::vector<std::size_t> priority(vertices);
+        for (std::size_t rank = 0; rank < vertices; ++rank)
+        {
+            priority[ranked[rank]] = rank;
+        }
+        return priority;
+    }
+
+    template <typename V, typename G>
+    auto find_vertex_coloring(G const & g, coloring_order order)
+        -> vertex_coloring<V>
+    {
+        auto const adjacency = make_compact_adjacency(g);
+        auto const vertices  = adjacency.num_vertices();
+        auto const priority  = coloring_priorities(adjacency, order);
+
+        std::vector<std::atomic<std::size_t>> pending(vertices);
+        std::vector<std::size_t> color(vertices);
+        std::vector<std::size_t> ready{};
+        for (std::size_t v = 0; v < vertices; ++v)
+        {
+            std::size_t higher{};
+            for (auto e = adjacency.offsets[v]; e < adjacency.offsets[v + 1]; ++e)
+            {
+                higher += priority[adjacency.targets[e]] > priority[v] ? std::size_t{1} : std::size_t{0};
+            }
+            pending[v].store(higher, std::memory_order_relaxed);
+            if (higher == 0)
+            {
+                ready.emplace_back(v);
+            }
+        }
+
+        // every chunk of the round collects the vertices it made ready, the next round takes them all
+        while (!ready.empty())
+        {
+            auto const bounds = chunk_bounds(ready.size(), 1024);
+            std::vector<std::vector<std::size_t>> next(bounds.size() - 1);
+
+            thread_pool::instance().run(bounds.size() - 1, [&](std::size_t chunk)
+            {
+                // used[c] is set when some neighbor with the higher priority has the color c
+                std::vector<char> used{};
+                for (auto i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+                {
+                    auto const v = ready[i];
+                    used.assign(adjacency.degree(v) + 1, false);
+                    for (auto e = adjacency.offsets[v]; e < adjacency.offsets[v + 1]; ++e)
+                    {
+                        auto const u = adjacency.targets[e];
+                        if (priority[u] > priority[v] && color[u] < used.size())
+                        {
+                            used[color[u]] = true;
+                        }
+                    }
+                    color[v] = static_cast<std::size_t>(std::distance(std::cbegin(used),
+                                                                      std::find(std::cbegin(used), std::cend(used), false)));
+
+                    for (auto e = adjacency.offsets[v]; e < adjacency.offsets[v + 1]; ++e)
+                    {
+                        auto const u = adjacency.targets[e];
+                        if (priority[u] < priority[v] && pending[u].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        {
+                            next[chunk].emplace_back(u);
+                        }
+                    }
+                }
+            });
+
+            ready.clear();
+            for (auto const & made_ready : next)
+            {
+                ready.insert(std::end(ready), std::cbegin(made_ready), std::cend(made_ready));
+            }
+        }
+
+        vertex_coloring<V> ret_val{};
+        ret_val.colors.reserve(vertices);
+
+        std::size_t slot{};
+        for (auto it = g.cbegin(); it != g.cend(); ++it, ++slot)
+        {
+            if (color[slot] >= ret_val.classes.size())
+            {
+                ret_val.classes.resize(color[slot] + 1);
+            }
+            ret_val.colors.emplace_back(std::pair{it->first, color[slot]});
+            ret_val.classes[color[slot]].emplace_back(it->first);
+        }
+
+        return ret_val;
+    }
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_vertex_coloring(graph<V,undirected> const & g)
+    -> vertex_coloring<V>
+{
+    return find_vertex_coloring(g, coloring_order::smallest_last);
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_vertex_coloring(graph<V,undirected> const & g, coloring_order order)
+    -> vertex_coloring<V>
+{
+    static_assert(undirected == true, "graph has to be undirected");
+
+    return detail::find_vertex_coloring<V>(g, order);
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_vertex_coloring(induced_subgraph<V,undirected> const & g)
+    -> vertex_coloring<V>
+{
+    return find_vertex_coloring(g, coloring_order::smallest_last);
+}
+
+template <typename V, bool undirected>
+auto graph_lib::find_vertex_coloring(induced_subgraph<V,undirected> const & g, coloring_order order)
+    -> vertex_coloring<V>
+{
+    static_assert(undirected == true, "graph has to be undirected");
+
+    return detail::find_vertex_coloring<V>(g, order);
+}
@@ -0,0 +1,337 @@
+#pragma once
+
+/*
+    Reading the graphs from the files and writing the graphs and the results of the algorithms.
+    Following formats are supported:
+
+    read_off(input)          Object File Format mesh, vertices are numbered 0 ... n-1 in the order of the file,
+                             edges of the graph are the sides of the faces, coordinates are skipped
+    read_edge_list(input)    One undirected edge "u v" per line, every edge is listed once,
+                             vertices are ordered by their first appearance
+
+    Lines that start with # and the empty lines are skipped. Both readers return the adjacency list
+    for the graph constructor, or nothing if the input is malformed. The list isn't validated,
+    use the validating constructor of the graph for that (see graph_validation.hpp).
+
+    write_edge_list(out, g)          Every edge "u v" on its own line, readable by read_edge_list
+                                     (for the undirected graph every edge is written once)
+    write_triangles(out, T)          Every triple "u v w" on its own line
+    write_tetrahedra(out, S)         Every tetrahedron "q u v w" on its own line
+    write_tetgen_ele(out, S)         TetGen .ele file of the tetrahedra, vertices are used as the node indices
+    write_tetgen_node(out, points)   TetGen .node file, the point i gets the index i
+    write_binary(out, g)             Edges in the binary format
+    write_binary(out, items)         Triangles, tetrahedra or any other tuples of vertices in the binary format
+
+    Writers append to the output_buffer (see output_buffer.hpp), text is formatted with std::to_chars.
+    Binary format is the header followed by the vertices of all of the items, in the byte order of the machine:
+
+        char[4]     magic "GLB1"
+        uint32      vertices per item (2 for the edges, 3 for the triangles, 4 for the tetrahedra)
+        uint32      size of the vertex in bytes
+        uint32      reserved, 0
+        uint64      number of items
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "output_buffer.hpp"
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <type_traits>
+
+namespace graph_lib::detail
+{
+    // reads the next line that isn't empty or a comment, returns false at the end of the input
+    inline bool next_data_line(std::istream & input, std::istringstream & line)
+    {
+        std::string text{};
+        while (std::getline(input, text))
+        {
+            auto const first = text.find_first_not_of(" \t\r");
+            if (first == std::string::npos || text[first] == '#')
+            {
+                continue;
+            }
+            line.clear();
+            line.str(text);
+            return true;
+        }
+        return false;
+    }
+
+    // vertex with the given index, for the formats that number the vertices
+    template <typename V>
+    auto vertex_from_index(std::size_t index)
+        -> V
+    {
+        if constexpr (std::is_same_v<V, std::size_t>)
+        {
+            return index;
+        }
+        else
+        {
+            return static_cast<V>(index);
+        }
+    }
+
+    inline void write_binary_header(output_buffer & output, std::uint32_t arity, std::uint32_t size, std::uint64_t count)
+    {
+        output.write("GLB1");
+        output.raw(arity);
+        output.raw(size);
+        output.raw(std::uint32_t{0});
+        output.raw(count);
+    }
+
+    // writes the values of the tuple separated by spaces, followed by the new line
+    template <typename Tuple>
+    void write_text_line(output_buffer & output, Tuple const & item)
+    {
+        std::apply([&](auto const & first, auto const & ... rest)
+        {
+            output.value(first);
+            ((output.put(' '), output.value(rest)), ...);
+            output.put('\n');
+        }, item);
+    }
+
+    // whether only the whitespace is left in the line
+    inline bool at_line_end(std::istringstream & line)
+    {
+        line >> std::ws;
+        return line.eof();
+    }
+}
+
+/*
+OFF
+vertices faces edges
+x y z                       (one line for each vertex)
+k i_1 i_2 ... i_k           (one line for each face, optionally followed by the color)
+
+For each face
+    for each side (i_j, i_j+1) of the face, including (i_k, i_1)
+        insert i_j+1 into the neighbors of i_j and i_j into the neighbors of i_j+1
+Sort the neighbors of every vertex and remove the repeated ones, since the neighboring faces share the sides
+*/
+template <typename V>
+auto graph_lib::read_off(std::istream & input)
+    -> std::optional<typename graph<V>::graph_vector_type>
+{
+    std::istringstream line{};
+    std::string header{};
+
+    if (!detail::next_data_line(input, line) || !(line >> header) || header != "OFF")
+    {
+        return std::nullopt;
+    }
+
+    // counts are allowed to be on the same line as the header
+    if (detail::at_line_end(line) && !detail::next_data_line(input, line))
+    {
+        return std::nullopt;
+    }
+
+    std::size_t vertices{}, faces{}, edges{};
+    if (!(line >> vertices >> faces >> edges))
+    {
+        return std::nullopt;
+    }
+
+    for (std::size_t i = 0; i < vertices; ++i)
+    {
+        if (!detail::next_data_line(input, line))
+        {
+            return std::nullopt;
+        }
+    }
+
+    std::vector<std::vector<V>> neighbors(vertices);
+    std::vector<std::size_t> face{};
+
+    for (std::size_t i = 0; i < faces; ++i)
+    {
+        std::size_t sides{};
+        if (!detail::next_data_line(input, line) || !(line >> sides) || sides < 3)
+        {
+            return std::nullopt;
+        }
+
+        face.resize(sides);
+        for (auto & index : face)
+        {
+            if (!(line >> index) || index >= vertices)
+            {
+                return std::nullopt;
+            }
+        }
+
+        for (std::size_t j = 0; j < sides; ++j)
+        {
+            auto const a = face[j];
+            auto const b = face[(j + 1) % sides];
+            neighbors[a].emplace_back(detail::vertex_from_index<V>(b));
+            neighbors[b].emplace_back(detail::vertex_from_index<V>(a));
+        }
+    }
+
+    typename graph<V>::graph_vector_type adjacency_list{};
+    adjacency_list.reserve(vertices);
+
+    for (std::size_t i = 0; i < vertices; ++i)
+    {
+        auto & list = neighbors[i];
+        std::sort(std::begin(list), std::end(list));
+        list.erase(std::unique(std::begin(list), std::end(list)), std::end(list));
+        adjacency_list.emplace_back(detail::vertex_from_index<V>(i), std::move(list));
+    }
+
+    return adjacency_list;
+}
+
+template <typename V>
+auto graph_lib::read_edge_list(std::istream & input)
+    -> std::optional<typename graph<V>::graph_vector_type>
+{
+    typename graph<V>::graph_vector_type adjacency_list{};
+    std::unordered_map<V, std::size_t> slots{};
+
+    auto const slot_of = [&](V const & vertex)
+    {
+        auto const [it, inserted] = slots.emplace(vertex, adjacency_list.size());
+        if (inserted)
+        {
+            adjacency_list.emplace_back(vertex, std::vector<V>{});
+        }
+        return it->second;
+    };
+
+    std::istringstream line{};
+    while (detail::next_data_line(input, line))
+    {
+        V u{}, v{};
+        if (!(line >> u >> v) || !detail::at_line_end(line))
+        {
+            return std::nullopt;
+        }
+
+        auto const first  = slot_of(u);
+        auto const second = slot_of(v);
+        adjacency_list[first].second.emplace_back(v);
+        adjacency_list[second].second.emplace_back(u);
+    }
+
+    return adjacency_list;
+}
+
+template <typename V, bool undirected>
+void graph_lib::write_edge_list(output_buffer & output, graph<V,undirected> const & g)
+{
+    auto const & index = g.vertex_index();
+
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        auto const slot = index.at(it->first);
+        for (auto const & neighbor : it->second.get())
+        {
+            // undirected edge is written from the endpoint that comes first
+            if (undirected == false || slot < index.at(neighbor))
+            {
+                detail::write_text_line(output, std::tie(it->first, neighbor));
+            }
+        }
+    }
+}
+
+template <typename V>
+void graph_lib::write_triangles(output_buffer & output, std::vector<std::tuple<V,V,V>> const & T)
+{
+    for (auto const & triangle : T)
+    {
+        detail::write_text_line(output, triangle);
+    }
+}
+
+template <typename V>
+void graph_lib::write_tetrahedra(output_buffer & output, std::vector<std::tuple<V,V,V,V>> const & S)
+{
+    for (auto const & tetrahedron : S)
+    {
+        detail::write_text_line(output, tetrahedron);
+    }
+}
+
+/*
+<number of tetrahedra> 4 0
+<index> <node> <node> <node> <node>     (one line for each tetrahedron)
+*/
+template <typename V>
+void graph_lib::write_tetgen_ele(output_buffer & output, std::vector<std::tuple<V,V,V,V>> const & S)
+{
+    static_assert(std::is_integral_v<V>, "TetGen refers to the nodes by their integral indices");
+
+    detail::write_text_line(output, std::tuple{std::size(S), 4, 0});
+
+    std::size_t index{};
+    for (auto const & [q, u, v, w] : S)
+    {
+        detail::write_text_line(output, std::tie(index, q, u, v, w));
+        ++index;
+    }
+}
+
+/*
+<number of points> 3 0 0
+<index> <x> <y> <z>                     (one line for each point)
+*/
+inline void graph_lib::write_tetgen_node(output_buffer & output, std::vector<std::array<double, 3>> const & points)
+{
+    detail::write_text_line(output, std::tuple{std::size(points), 3, 0, 0});
+
+    for (std::size_t index = 0; index < std::size(points); ++index)
+    {
+        auto const & [x, y, z] = points[index];
+        detail::write_text_line(output, std::tie(index, x, y, z));
+    }
+}
+
+template <typename V, bool undirected>
+void graph_lib::write_binary(output_buffer & output, graph<V,undirected> const & g)
+{
+    static_assert(std::is_trivially_copyable_v<V>, "only trivially copyable vertices can be written as bytes");
+
+    detail::write_binary_header(output, 2, static_cast<std::uint32_t>(sizeof(V)), g.num_edges());
+
+    auto const & index = g.vertex_index();
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        auto const slot = index.at(it->first);
+        for (auto const & neighbor : it->second.get())
+        {
+            if (undirected == false || slot < index.at(neighbor))
+            {
+                output.raw(it->first);
+                output.raw(neighbor);
+            }
+        }
+    }
+}
+
+template <typename... V>
+void graph_lib::write_binary(output_buffer & output, std::vector<std::tuple<V...>> const & items)
+{
+    using vertex_type = std::tuple_element_t<0, std::tuple<V...>>;
+    static_assert((std::is_same_v<V, vertex_type> && ...), "all of the vertices of the item must have the same type");
+    static_assert(std::is_trivially_copyable_v<vertex_type>, "only trivially copyable vertices can be written as bytes");
+
+    detail::write_binary_header(output, static_cast<std::uint32_t>(sizeof...(V)),
+                                static_cast<std::uint32_t>(sizeof(vertex_type)), std::size(items));
+
+    for (auto const & item : items)
+    {
+        std::apply([&](auto const & ... vertices){ (output.raw(vertices), ...); }, item);
+    }
+}
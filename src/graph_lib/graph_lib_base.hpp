@@ -1,5 +1,12 @@
 #pragma once
 #include <vector>
+#include <optional>
+#include <iosfwd>
+#include <array>
+#include <tuple>
+#include <string>
+#include <cstdint>
+#include "execution.hpp"
 /*  This is only used to declare all of the classes in one namespace
 */
 
@@ -7,6 +14,41 @@ namespace graph_lib{
     template <typename V, bool undirected = true>
     class graph;
 
+    struct graph_memory_usage;
+
+    template <typename T>
+    struct vertex_property;
+
+    template <typename T>
+    struct edge_property;
+
+    template <typename N, bool undirected = true>
+    class edge;
+
+    template <typename V, bool undirected = true>
+    class induced_subgraph;
+
+    template <typename V, bool undirected = true>
+    class mutation_batch;
+
+    template <typename V, bool undirected = true>
+    class compressed_graph;
+
+    template <typename T>
+    class cow_vector;
+
+    template <typename V>
+    struct validation_report;
+
+    template <typename T>
+    class bounded_queue;
+
+    class output_buffer;
+
+    struct cache_statistics;
+
+    class result_cache;
+
     template <typename V, bool undirected>
     auto find_orders_of_vertices(graph<V,undirected> const & g)
         -> typename std::vector<std::pair<V, typename graph<V,undirected>::edges_size_type>>;
@@ -20,8 +62,225 @@ namespace graph_lib{
     auto find_triangular_faces(graph<V,undirected> const & g)
         -> typename std::vector<std::tuple<V,V,V>>;
     
+    template <typename V, bool undirected, typename F>
+    void for_each_triangular_face(graph<V,undirected> const & g, F && fn);
+
     template <typename V>
     auto cone_triangulation(std::vector<std::tuple<V,V,V>> const & T, V q)
         -> typename std::vector<std::tuple<V,V,V,V>>;
 
+    // overloads that run on the induced subgraph, see subgraph_view.hpp
+    template <typename V, bool undirected>
+    auto find_orders_of_vertices(induced_subgraph<V,undirected> const & g)
+        -> typename std::vector<std::pair<V, typename graph<V,undirected>::edges_size_type>>;
+
+    template <typename V, bool undirected>
+    auto find_all_connected_vertices_of_the_same_degree(induced_subgraph<V,undirected> const & g,
+                                                        typename graph<V,undirected>::edges_size_type const & degree)
+        -> typename std::vector<std::pair<V,V>>;
+
+    template <typename V, bool undirected>
+    auto find_triangular_faces(induced_subgraph<V,undirected> const & g)
+        -> typename std::vector<std::tuple<V,V,V>>;
+
+    template <typename V, bool undirected, typename F>
+    void for_each_triangular_face(induced_subgraph<V,undirected> const & g, F && fn);
+
+    // overloads that take the execution policy, see execution.hpp
+    template <typename ExecutionPolicy, typename V, bool undirected>
+    auto find_orders_of_vertices(ExecutionPolicy && policy, graph<V,undirected> const & g)
+        -> std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>,
+                            std::vector<std::pair<V, typename graph<V,undirected>::edges_size_type>>>;
+
+    template <typename ExecutionPolicy, typename V, bool undirected>
+    auto find_all_connected_vertices_of_the_same_degree(ExecutionPolicy && policy, graph<V,undirected> const & g,
+                                                        typename graph<V,undirected>::edges_size_type const & degree)
+        -> std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, std::vector<std::pair<V,V>>>;
+
+    template <typename ExecutionPolicy, typename V>
+    auto cone_triangulation(ExecutionPolicy && policy, std::vector<std::tuple<V,V,V>> const & T, V q)
+        -> std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, std::vector<std::tuple<V,V,V,V>>>;
+
+    template <typename Face>
+    auto dual_graph(std::vector<Face> const & faces)
+        -> graph<std::size_t>;
+
+    template <typename ExecutionPolicy, typename Face>
+    auto dual_graph(ExecutionPolicy && policy, std::vector<Face> const & faces)
+        -> std::enable_if_t<execution::is_execution_policy_v<ExecutionPolicy>, graph<std::size_t>>;
+
+    template <typename V, bool undirected, typename Face>
+    auto dual_graph(graph<V,undirected> const & g, std::vector<Face> const & faces)
+        -> graph<std::size_t>;
+
+    template <typename V>
+    struct connected_components;
+
+    template <typename V, bool undirected>
+    auto find_connected_components(graph<V,undirected> const & g)
+        -> connected_components<V>;
+
+    template <typename V, bool undirected>
+    auto find_connected_components(induced_subgraph<V,undirected> const & g)
+        -> connected_components<V>;
+
+    template <typename V, bool undirected>
+    auto is_connected(graph<V,undirected> const & g)
+        -> bool;
+
+    template <typename V>
+    struct core_decomposition;
+
+    template <typename V, bool undirected>
+    auto find_core_decomposition(graph<V,undirected> const & g)
+        -> core_decomposition<V>;
+
+    template <typename V, bool undirected>
+    auto find_core_decomposition(induced_subgraph<V,undirected> const & g)
+        -> core_decomposition<V>;
+
+    enum class coloring_order;
+
+    template <typename V>
+    struct vertex_coloring;
+
+    template <typename V, bool undirected>
+    auto find_vertex_coloring(graph<V,undirected> const & g)
+        -> vertex_coloring<V>;
+
+    template <typename V, bool undirected>
+    auto find_vertex_coloring(graph<V,undirected> const & g, coloring_order order)
+        -> vertex_coloring<V>;
+
+    template <typename V, bool undirected>
+    auto find_vertex_coloring(induced_subgraph<V,undirected> const & g)
+        -> vertex_coloring<V>;
+
+    template <typename V, bool undirected>
+    auto find_vertex_coloring(induced_subgraph<V,undirected> const & g, coloring_order order)
+        -> vertex_coloring<V>;
+
+    template <typename V>
+    auto find_triangles(compressed_graph<V, true> const & g)
+        -> typename std::vector<std::tuple<V,V,V>>;
+
+    struct triangle_estimate;
+    struct sampling_options;
+
+    template <typename V, bool undirected>
+    auto count_triangles(graph<V,undirected> const & g)
+        -> std::size_t;
+
+    template <typename V>
+    auto count_triangles(compressed_graph<V, true> const & g)
+        -> std::size_t;
+
+    template <typename V, bool undirected>
+    auto count_triangles(induced_subgraph<V,undirected> const & g)
+        -> std::size_t;
+
+    template <typename V, bool undirected>
+    auto estimate_triangles_doulion(graph<V,undirected> const & g, sampling_options const & options)
+        -> triangle_estimate;
+
+    template <typename V, bool undirected>
+    auto estimate_triangles_wedge(graph<V,undirected> const & g, sampling_options const & options)
+        -> triangle_estimate;
+
+    template <typename V, bool undirected>
+    auto find_planar_embedding(graph<V,undirected> const & g)
+        -> std::optional<typename graph<V,undirected>::graph_vector_type>;
+
+    template <typename V, bool undirected>
+    auto is_planar(graph<V,undirected> const & g)
+        -> bool;
+
+    template <typename V, bool undirected>
+    auto is_biconnected(graph<V,undirected> const & g)
+        -> bool;
+
+    template <typename V, bool undirected>
+    auto is_polyhedral(graph<V,undirected> const & g)
+        -> bool;
+
+    template <typename V, typename D>
+    struct distance_matrix;
+
+    template <typename D = std::uint16_t, typename V, bool undirected>
+    auto find_distances(graph<V,undirected> const & g, std::vector<V> const & sources)
+        -> std::optional<distance_matrix<V, D>>;
+
+    template <typename D = std::uint16_t, typename V, bool undirected>
+    auto find_all_distances(graph<V,undirected> const & g)
+        -> std::optional<distance_matrix<V, D>>;
+
+    struct tetrahedra_measures;
+
+    auto orient3d(std::array<double, 3> const & a, std::array<double, 3> const & b,
+                  std::array<double, 3> const & c, std::array<double, 3> const & d)
+        -> int;
+
+    auto measure_tetrahedra(std::vector<std::array<double, 3>> const & points,
+                            std::vector<std::array<std::size_t, 4>> const & T)
+        -> tetrahedra_measures;
+
+    template <typename V, bool undirected>
+    auto measure_tetrahedra(graph<V,undirected> const & g, vertex_property<std::array<double, 3>> position,
+                            std::vector<std::tuple<V,V,V,V>> const & S)
+        -> tetrahedra_measures;
+
+    template <typename V>
+    auto read_off(std::istream & input)
+        -> std::optional<typename graph<V>::graph_vector_type>;
+
+    template <typename V>
+    auto read_edge_list(std::istream & input)
+        -> std::optional<typename graph<V>::graph_vector_type>;
+
+    template <typename V>
+    struct graph_partition;
+
+    template <typename V, bool undirected>
+    auto partition_graph(graph<V,undirected> const & g, std::size_t parts)
+        -> graph_partition<V>;
+
+    template <typename V>
+    struct partitioned_results;
+
+    template <typename V, bool undirected>
+    auto run_partitioned(graph<V,undirected> const & g, graph_partition<V> const & partition,
+                         std::vector<V> const & degree_queries)
+        -> std::optional<partitioned_results<V>>;
+
+    struct external_memory_options;
+
+    template <typename V>
+    auto edge_list_source(std::string path);
+
+    template <typename V, typename EdgeSource, typename F>
+    bool find_triangles_external(EdgeSource && source, F && fn, external_memory_options const & options);
+
+    template <typename V, typename EdgeSource, typename F>
+    bool find_triangles_external(EdgeSource && source, F && fn);
+
+    template <typename V, bool undirected>
+    void write_edge_list(output_buffer & output, graph<V,undirected> const & g);
+
+    template <typename V>
+    void write_triangles(output_buffer & output, std::vector<std::tuple<V,V,V>> const & T);
+
+    template <typename V>
+    void write_tetrahedra(output_buffer & output, std::vector<std::tuple<V,V,V,V>> const & S);
+
+    template <typename V>
+    void write_tetgen_ele(output_buffer & output, std::vector<std::tuple<V,V,V,V>> const & S);
+
+    void write_tetgen_node(output_buffer & output, std::vector<std::array<double, 3>> const & points);
+
+    template <typename V, bool undirected>
+    void write_binary(output_buffer & output, graph<V,undirected> const & g);
+
+    template <typename... V>
+    void write_binary(output_buffer & output, std::vector<std::tuple<V...>> const & items);
+
 }
\ No newline at end of file
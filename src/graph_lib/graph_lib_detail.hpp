@@ -0,0 +1,323 @@
+#pragma once
+
+/*
+    Internal helpers shared by the algorithms, they are not a part of the public interface.
+
+    make_vertex_slots(g)         Map every vertex of G to its position (slot) in the adjacency list
+    make_compact_adjacency(g)    Copy of the adjacency of G where neighbors are replaced by their slots,
+                                 reuses the vertex index of G when G maintains one
+    make_vertex_pointers(g)      Pointers to the vertices of G in the order of the slots
+    chunk_bounds(n, grain)       Split [0, n) into at most one chunk per thread of the pool
+    parallel_for(n, fn)          Split [0, n) into chunks and call fn(begin, end) for each chunk in parallel
+    parallel_sort(first, last)   Stable sort, chunks are sorted in parallel and then merged pairwise
+    parallel_emit(n, cnt, emit)  Parallel filter/expand of [0, n) into the vector, in the order of the serial loop
+    prefetch(address)            Hint the processor to start loading the address into the cache
+    peel_cores(adjacency)        Core numbers and the degeneracy ordering of the compact adjacency, in O(V+E)
+*/
+
+#include "graph_lib_base.hpp"
+#include "thread_pool.hpp"
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+#include <assert.h>
+
+namespace graph_lib::detail
+{
+    // software prefetch for reading, compiles to nothing on compilers without the builtin
+    inline void prefetch([[maybe_unused]] void const * address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#endif
+    }
+
+    // splits the range [0, count) into contiguous chunks of at least grain elements, one per thread at most
+    // chunk i is [bounds[i], bounds[i + 1]), the split depends only on the count, so two passes
+    // over the same range get the same chunks
+    inline auto chunk_bounds(std::size_t count, std::size_t grain = 4096)
+        -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> bounds{0};
+        if (count == 0)
+        {
+            return bounds;
+        }
+
+        std::size_t const threads = thread_pool::instance().size();
+        std::size_t const chunks  = std::min(threads, (count + grain - 1) / grain);
+        std::size_t const step    = (count + chunks - 1) / chunks;
+
+        for (auto begin = step; begin < count; begin += step)
+        {
+            bounds.emplace_back(begin);
+        }
+        bounds.emplace_back(count);
+
+        return bounds;
+    }
+
+    // calls fn(begin, end) for every chunk of the range [0, count) on the thread pool
+    // small inputs are a single chunk, which runs on the calling thread
+    template <typename F>
+    void parallel_for(std::size_t count, F && fn, std::size_t grain = 4096)
+    {
+        auto const bounds = chunk_bounds(count, grain);
+
+        thread_pool::instance().run(bounds.size() - 1, [&](std::size_t chunk)
+        {
+            fn(bounds[chunk], bounds[chunk + 1]);
+        });
+    }
+
+    // stable sort of the random access range, chunks are sorted in parallel and then merged
+    // in rounds, neighboring runs are merged in parallel within every round
+    template <typename It, typename Compare>
+    void parallel_sort(It first, It last, Compare comp, std::size_t grain = 4096)
+    {
+        auto const count  = static_cast<std::size_t>(std::distance(first, last));
+        auto const bounds = chunk_bounds(count, grain);
+        auto const runs   = bounds.size() - 1;
+        auto const at     = [&](std::size_t position){ return std::next(first, static_cast<std::ptrdiff_t>(position)); };
+
+        thread_pool::instance().run(runs, [&](std::size_t run)
+        {
+            std::stable_sort(at(bounds[run]), at(bounds[run + 1]), comp);
+        });
+
+        for (std::size_t width = 1; width < runs; width *= 2)
+        {
+            auto const merges = (runs + 2 * width - 1) / (2 * width);
+            thread_pool::instance().run(merges, [&](std::size_t merge)
+            {
+                auto const begin  = merge * 2 * width;
+                auto const middle = std::min(runs, begin + width);
+                auto const end    = std::min(runs, begin + 2 * width);
+                std::inplace_merge(at(bounds[begin]), at(bounds[middle]), at(bounds[end]), comp);
+            });
+        }
+    }
+
+    // parallel version of the loop that emits some number of results for every item in [0, count)
+    // count_fn(i) returns how many results the item i emits, emit_fn(i, out) writes them to out and
+    // returns the iterator past them; the first pass counts the results of every chunk, so every chunk
+    // writes from its own fixed offset and no locks are taken on the output
+    template <typename T, typename Count, typename Emit>
+    auto parallel_emit(std::size_t count, Count && count_fn, Emit && emit_fn, std::size_t grain = 4096)
+        -> std::vector<T>
+    {
+        auto const bounds = chunk_bounds(count, grain);
+        auto const chunks = bounds.size() - 1;
+
+        std::vector<std::size_t> offsets(chunks + 1);
+        thread_pool::instance().run(chunks, [&](std::size_t chunk)
+        {
+            for (auto i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+            {
+                offsets[chunk + 1] += count_fn(i);
+            }
+        });
+        std::partial_sum(std::begin(offsets), std::end(offsets), std::begin(offsets));
+
+        std::vector<T> results(offsets.back());
+        thread_pool::instance().run(chunks, [&](std::size_t chunk)
+        {
+            auto out = std::next(std::begin(results), static_cast<std::ptrdiff_t>(offsets[chunk]));
+            for (auto i = bounds[chunk]; i < bounds[chunk + 1]; ++i)
+            {
+                out = emit_fn(i, out);
+            }
+        });
+
+        return results;
+    }
+
+    // maps every vertex to its position inside the adjacency list of the graph
+    template <typename G>
+    auto make_vertex_slots(G const & g)
+        -> std::unordered_map<typename G::node_type, std::size_t>
+    {
+        std::unordered_map<typename G::node_type, std::size_t> slots{};
+        slots.reserve(g.num_vertices());
+
+        std::size_t slot{};
+        for (auto it = g.cbegin(); it != g.cend(); ++it)
+        {
+            [[maybe_unused]] auto const inserted = slots.emplace(it->first, slot++).second;
+            assert(inserted);
+        }
+
+        return slots;
+    }
+
+    // pointers to the vertices of the graph in the order of the slots, valid until the graph is modified
+    template <typename G>
+    auto make_vertex_pointers(G const & g)
+        -> std::vector<typename G::node_type const *>
+    {
+        std::vector<typename G::node_type const *> vertices{};
+        vertices.reserve(g.num_vertices());
+        for (auto it = g.cbegin(); it != g.cend(); ++it)
+        {
+            vertices.emplace_back(&it->first);
+        }
+        return vertices;
+    }
+
+    // adjacency of the graph in the compressed sparse row form
+    // neighbors of the vertex in slot i are targets[offsets[i]] ... targets[offsets[i+1] - 1]
+    struct compact_adjacency
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> targets;
+
+        [[nodiscard]] auto num_vertices() const noexcept
+            -> std::size_t
+        {
+            return offsets.size() - 1;
+        }
+
+        [[nodiscard]] auto degree(std::size_t slot) const noexcept
+            -> std::size_t
+        {
+            return offsets[slot + 1] - offsets[slot];
+        }
+    };
+
+    // builds the compact adjacency of the graph, neighbors are resolved in parallel
+    // asserts that every neighbor is a vertex of the graph
+    template <typename G>
+    auto make_compact_adjacency(G const & g, std::unordered_map<typename G::node_type, std::size_t> const & slots)
+        -> compact_adjacency
+    {
+        compact_adjacency adjacency{};
+        adjacency.offsets.reserve(g.num_vertices() + 1);
+        adjacency.offsets.emplace_back(0);
+
+        // iterators rather than the pointers to the lists, the views create their lists on the fly
+        std::vector<decltype(g.cbegin())> lists{};
+        lists.reserve(g.num_vertices());
+
+        for (auto it = g.cbegin(); it != g.cend(); ++it)
+        {
+            adjacency.offsets.emplace_back(adjacency.offsets.back() + std::size(it->second));
+            lists.emplace_back(it);
+        }
+
+        adjacency.targets.resize(adjacency.offsets.back());
+
+        parallel_for(lists.size(), [&](std::size_t begin, std::size_t end)
+        {
+            for (auto slot = begin; slot < end; ++slot)
+            {
+                auto position = adjacency.offsets[slot];
+                auto const & [vertex, neighbors] = *lists[slot];
+                (void) vertex;
+                for (auto const & neighbor : neighbors)
+                {
+                    auto const found = slots.find(neighbor);
+                    assert(found != std::cend(slots));
+                    adjacency.targets[position++] = found->second;
+                }
+            }
+        }, 1024);
+
+        return adjacency;
+    }
+
+    // whether G maintains the map from the vertex to its slot, so it doesn't have to be rebuilt
+    template <typename G, typename = void>
+    struct has_vertex_index : std::false_type {};
+
+    template <typename G>
+    struct has_vertex_index<G, std::void_t<decltype(std::declval<G const &>().vertex_index())>> : std::true_type {};
+
+    template <typename G>
+    auto make_compact_adjacency(G const & g)
+        -> compact_adjacency
+    {
+        if constexpr (has_vertex_index<G>::value)
+        {
+            return make_compact_adjacency(g, g.vertex_index());
+        }
+        else
+        {
+            return make_compact_adjacency(g, make_vertex_slots(g));
+        }
+    }
+
+    // result of peel_cores, vertices are referred to by their slots
+    struct core_peeling
+    {
+        // core number of every vertex, indexed by the slot
+        std::vector<std::size_t> core;
+        // vertices in the order they were peeled, every vertex has at most degeneracy later neighbors
+        std::vector<std::size_t> order;
+        // largest core number
+        std::size_t degeneracy;
+    };
+
+    // bucket queue peeling (Batagelj, Zaversnik): vertices are kept sorted by the current degree in one array,
+    // bucket[d] is where the vertices of degree d start, lowering the degree swaps the vertex to the front of
+    // its bucket and moves the bucket boundary behind it, so every edge is handled in O(1)
+    inline auto peel_cores(compact_adjacency const & adjacency)
+        -> core_peeling
+    {
+        auto const vertices = adjacency.num_vertices();
+        std::vector<std::size_t> degree(vertices);
+        std::size_t max_degree{};
+        for (std::size_t v = 0; v < vertices; ++v)
+        {
+            degree[v] = adjacency.degree(v);
+            max_degree = std::max(max_degree, degree[v]);
+        }
+
+        // counting sort by the degree
+        std::vector<std::size_t> bucket(max_degree + 2);
+        for (auto const d : degree)
+        {
+            ++bucket[d + 1];
+        }
+        std::partial_sum(std::cbegin(bucket), std::cend(bucket), std::begin(bucket));
+
+        std::vector<std::size_t> order(vertices);
+        std::vector<std::size_t> position(vertices);
+        {
+            auto next = bucket;
+            for (std::size_t v = 0; v < vertices; ++v)
+            {
+                position[v] = next[degree[v]]++;
+                order[position[v]] = v;
+            }
+        }
+
+        std::size_t degeneracy{};
+        for (std::size_t i = 0; i < vertices; ++i)
+        {
+            auto const v = order[i];
+            degeneracy = std::max(degeneracy, degree[v]);
+
+            for (auto e = adjacency.offsets[v]; e < adjacency.offsets[v + 1]; ++e)
+            {
+                auto const u = adjacency.targets[e];
+                if (degree[u] > degree[v])
+                {
+                    // swap u with the first vertex of its bucket and shrink the bucket from the front
+                    auto const d     = degree[u];
+                    auto const first = bucket[d];
+                    auto const w     = order[first];
+                    std::swap(order[first], order[position[u]]);
+                    position[w] = position[u];
+                    position[u] = first;
+                    bucket[d] = first + 1;
+                    --degree[u];
+                }
+            }
+        }
+
+        return core_peeling{std::move(degree), std::move(order), degeneracy};
+    }
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+/*
+    Property columns attached to the graph (see the properties of graph.hpp).
+    Vertex property is one dense vector indexed by the slot of the vertex, edge property is one list per vertex,
+    parallel to its neighbor list, so the value of the edge (v, list[i]) is at the position i of the column of v.
+    Undirected edge has a value on both of its ends, setting the value through the graph sets both of them.
+
+    Columns are kept in the sync with the graph by the hooks the graph calls on every modification:
+
+    on_insert_vertex()             New vertex was appended, it gets the default value (vertex) or the empty list (edge)
+    on_remove_vertex(slot)         Vertex at the slot was removed, the later slots move one to the front
+    on_reorder(order)              Vertices were reordered, the new slot i holds the vertex from the old slot order[i]
+    on_insert_edge(slot)           Neighbor was appended to the list of the slot, it gets the default value
+    on_remove_edge(slot, i)        Neighbor at the position i of the list of the slot was removed
+
+    Columns are shared between the copies of the graph and copied the first time one of the copies modifies
+    them, just like the neighbor lists. Lists of the edge columns are copy-on-write vectors themselves, so
+    the copy only copies the handles and the lists touched later.
+*/
+
+#include "graph_lib_base.hpp"
+#include "cow_vector.hpp"
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <assert.h>
+
+// handle of the vertex property of the type T, returned by graph::add_vertex_property
+// valid for the graph that created it and for all of its copies
+template <typename T>
+struct graph_lib::vertex_property
+{
+    std::size_t column;
+};
+
+// handle of the edge property of the type T, returned by graph::add_edge_property
+template <typename T>
+struct graph_lib::edge_property
+{
+    std::size_t column;
+};
+
+namespace graph_lib::detail
+{
+    // column of any type, vertex columns ignore the edge hooks
+    class property_column
+    {
+    public:
+        virtual ~property_column() = default;
+
+        virtual void on_insert_vertex() = 0;
+        virtual void on_remove_vertex(std::size_t slot) = 0;
+        virtual void on_reorder(std::vector<std::size_t> const & order) = 0;
+        virtual void on_insert_edge(std::size_t) {}
+        virtual void on_remove_edge(std::size_t, std::size_t) {}
+        virtual void shrink_to_fit() = 0;
+
+        [[nodiscard]] virtual auto clone() const -> std::shared_ptr<property_column> = 0;
+        [[nodiscard]] virtual auto used_bytes() const noexcept -> std::size_t = 0;
+        [[nodiscard]] virtual auto allocated_bytes() const noexcept -> std::size_t = 0;
+    };
+
+    // moves the elements so the new position i holds the element from the old position order[i]
+    template <typename Container>
+    void reorder(Container & elements, std::vector<std::size_t> const & order)
+    {
+        Container reordered{};
+        reordered.reserve(elements.size());
+        for (auto const old_slot : order)
+        {
+            reordered.emplace_back(std::move(elements[old_slot]));
+        }
+        elements = std::move(reordered);
+    }
+
+    template <typename T>
+    class vertex_column final : public property_column
+    {
+    public:
+
+        std::vector<T> values;
+        T              default_value;
+
+        vertex_column(std::size_t vertices, T default_value_)
+            : values(vertices, default_value_), default_value{std::move(default_value_)}
+        {
+        }
+
+        void on_insert_vertex() override
+        {
+            values.emplace_back(default_value);
+        }
+
+        void on_remove_vertex(std::size_t slot) override
+        {
+            values.erase(std::next(std::begin(values), static_cast<std::ptrdiff_t>(slot)));
+        }
+
+        void on_reorder(std::vector<std::size_t> const & order) override
+        {
+            reorder(values, order);
+        }
+
+        void shrink_to_fit() override
+        {
+            values.shrink_to_fit();
+        }
+
+        [[nodiscard]] auto clone() const
+            -> std::shared_ptr<property_column> override
+        {
+            return std::make_shared<vertex_column>(*this);
+        }
+
+        [[nodiscard]] auto used_bytes() const noexcept
+            -> std::size_t override
+        {
+            return values.size() * sizeof(T);
+        }
+
+        [[nodiscard]] auto allocated_bytes() const noexcept
+            -> std::size_t override
+        {
+            return values.capacity() * sizeof(T);
+        }
+    };
+
+    template <typename T>
+    class edge_column final : public property_column
+    {
+    public:
+
+        std::vector<cow_vector<T>> lists;
+        T                          default_value;
+
+        // degrees are the sizes of the neighbor lists, in the order of the slots
+        edge_column(std::vector<std::size_t> const & degrees, T default_value_)
+            : lists{}, default_value{std::move(default_value_)}
+        {
+            lists.reserve(degrees.size());
+            for (auto const degree : degrees)
+            {
+                lists.emplace_back(std::vector<T>(degree, default_value));
+            }
+        }
+
+        void on_insert_vertex() override
+        {
+            lists.emplace_back();
+        }
+
+        void on_remove_vertex(std::size_t slot) override
+        {
+            lists.erase(std::next(std::begin(lists), static_cast<std::ptrdiff_t>(slot)));
+        }
+
+        void on_reorder(std::vector<std::size_t> const & order) override
+        {
+            reorder(lists, order);
+        }
+
+        void on_insert_edge(std::size_t slot) override
+        {
+            lists[slot].mutate().emplace_back(default_value);
+        }
+
+        void on_remove_edge(std::size_t slot, std::size_t position) override
+        {
+            auto & values = lists[slot].mutate();
+            values.erase(std::next(std::begin(values), static_cast<std::ptrdiff_t>(position)));
+        }
+
+        void shrink_to_fit() override
+        {
+            lists.shrink_to_fit();
+            for (auto & list : lists)
+            {
+                list.shrink_to_fit();
+            }
+        }
+
+        [[nodiscard]] auto clone() const
+            -> std::shared_ptr<property_column> override
+        {
+            return std::make_shared<edge_column>(*this);
+        }
+
+        [[nodiscard]] auto used_bytes() const noexcept
+            -> std::size_t override
+        {
+            auto bytes = lists.size() * sizeof(cow_vector<T>);
+            for (auto const & list : lists)
+            {
+                bytes += list.size() * sizeof(T);
+            }
+            return bytes;
+        }
+
+        [[nodiscard]] auto allocated_bytes() const noexcept
+            -> std::size_t override
+        {
+            auto bytes = lists.capacity() * sizeof(cow_vector<T>);
+            for (auto const & list : lists)
+            {
+                bytes += list.capacity() * sizeof(T);
+            }
+            return bytes;
+        }
+    };
+}
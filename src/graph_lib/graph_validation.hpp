@@ -0,0 +1,174 @@
+#pragma once
+
+/*
+    Validation of the adjacency list before it is turned into the graph.
+    All of the problems are collected into one report instead of stopping at the first one:
+
+    duplicate_vertex         vertex appears more than once, neighbor is the same vertex
+    self_loop                vertex is listed as its own neighbor
+    repeated_neighbor        neighbor appears more than once in the list of the vertex
+    unknown_vertex           neighbor is not a vertex of the graph
+    asymmetric_edge          (undirected only) vertex lists the neighbor, but not the other way around
+
+    Vertices are indexed with one hash pass, every list is resolved and sorted on its own and the
+    symmetry is checked with binary searches over the sorted lists. Lists are processed in parallel,
+    so the whole validation takes O(V + E log(max degree)) work.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph_lib_detail.hpp"
+#include <mutex>
+
+template <typename V>
+struct graph_lib::validation_report
+{
+    enum class kind
+    {
+        duplicate_vertex,
+        self_loop,
+        repeated_neighbor,
+        unknown_vertex,
+        asymmetric_edge
+    };
+
+    struct violation
+    {
+        kind type;
+        V    vertex;
+        V    neighbor;
+
+        [[nodiscard]] friend bool operator==(violation const & first, violation const & second)
+        {
+            return first.type == second.type && first.vertex == second.vertex && first.neighbor == second.neighbor;
+        }
+    };
+
+    // violations ordered by the kind of the pass that found them and then by the position of the vertex
+    std::vector<violation> violations;
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return violations.empty();
+    }
+};
+
+namespace graph_lib::detail
+{
+    template <bool undirected, typename N>
+    auto validate_adjacency_list(std::vector<std::pair<N, std::vector<N>>> const & adjacency_list)
+        -> validation_report<N>
+    {
+        using kind      = typename validation_report<N>::kind;
+        using violation = typename validation_report<N>::violation;
+
+        validation_report<N> report{};
+        auto const vertices = std::size(adjacency_list);
+
+        std::unordered_map<N, std::size_t> slots{};
+        slots.reserve(vertices);
+        for (std::size_t slot = 0; slot < vertices; ++slot)
+        {
+            auto const & vertex = adjacency_list[slot].first;
+            if (!slots.emplace(vertex, slot).second)
+            {
+                report.violations.emplace_back(violation{kind::duplicate_vertex, vertex, vertex});
+            }
+        }
+
+        // sorted, resolved copy of every list, unknown neighbors are dropped
+        std::vector<std::size_t> offsets(vertices + 1);
+        for (std::size_t slot = 0; slot < vertices; ++slot)
+        {
+            offsets[slot + 1] = offsets[slot] + std::size(adjacency_list[slot].second);
+        }
+        std::vector<std::size_t> sorted(offsets.back());
+        std::vector<std::size_t> sizes(vertices);
+
+        // chunks report their violations tagged with the first slot, to restore the order afterwards
+        std::mutex mutex{};
+        std::vector<std::pair<std::size_t, std::vector<violation>>> found{};
+        auto const collect = [&](std::size_t begin, std::vector<violation> && local)
+        {
+            if (!local.empty())
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                found.emplace_back(begin, std::move(local));
+            }
+        };
+        auto const flush = [&]
+        {
+            std::sort(std::begin(found), std::end(found),
+                      [](auto const & first, auto const & second){ return first.first < second.first; });
+            for (auto & [begin, local] : found)
+            {
+                (void) begin;
+                std::move(std::begin(local), std::end(local), std::back_inserter(report.violations));
+            }
+            found.clear();
+        };
+
+        parallel_for(vertices, [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<violation> local{};
+            for (auto slot = begin; slot < end; ++slot)
+            {
+                auto const & [vertex, edges] = adjacency_list[slot];
+                auto const first = std::begin(sorted) + static_cast<std::ptrdiff_t>(offsets[slot]);
+                auto last = first;
+
+                for (auto const & neighbor : edges)
+                {
+                    auto const it = slots.find(neighbor);
+                    if (it == std::cend(slots))
+                    {
+                        local.emplace_back(violation{kind::unknown_vertex, vertex, neighbor});
+                    }
+                    else if (it->second == slot)
+                    {
+                        local.emplace_back(violation{kind::self_loop, vertex, neighbor});
+                    }
+                    else
+                    {
+                        *last++ = it->second;
+                    }
+                }
+
+                std::sort(first, last);
+                for (auto it = std::adjacent_find(first, last); it != last; it = std::adjacent_find(it, last))
+                {
+                    local.emplace_back(violation{kind::repeated_neighbor, vertex, adjacency_list[*it].first});
+                    it = std::upper_bound(it, last, *it);
+                }
+                sizes[slot] = static_cast<std::size_t>(std::distance(first, std::unique(first, last)));
+            }
+            collect(begin, std::move(local));
+        }, 1024);
+        flush();
+
+        if constexpr (undirected == true)
+        {
+            parallel_for(vertices, [&](std::size_t begin, std::size_t end)
+            {
+                std::vector<violation> local{};
+                for (auto slot = begin; slot < end; ++slot)
+                {
+                    for (auto i = offsets[slot]; i < offsets[slot] + sizes[slot]; ++i)
+                    {
+                        auto const neighbor = sorted[i];
+                        auto const first = std::cbegin(sorted) + static_cast<std::ptrdiff_t>(offsets[neighbor]);
+                        auto const last  = first + static_cast<std::ptrdiff_t>(sizes[neighbor]);
+                        if (!std::binary_search(first, last, slot))
+                        {
+                            local.emplace_back(violation{kind::asymmetric_edge, adjacency_list[slot].first,
+                                                                                adjacency_list[neighbor].first});
+                        }
+                    }
+                }
+                collect(begin, std::move(local));
+            }, 1024);
+            flush();
+        }
+
+        return report;
+    }
+}
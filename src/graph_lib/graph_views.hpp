@@ -0,0 +1,384 @@
+#pragma once
+
+/*
+    Lazy views over the graph, returned by vertices(), edges() and incident_edges(v) of graph.hpp.
+    Views only hold the iterators of the graph, so creating and iterating them doesn't allocate,
+    and they work with the standard algorithms that take the forward iterators:
+
+    vertices()               Vertices of G in the iteration order of G, as the const references
+    edges()                  Edges of G, every undirected edge exactly once (every arc for the directed G)
+    incident_edges(v)        Edges of v in the order of adjacent_vertices(v), v is always the source
+
+    Edge is the pair of the references to its endpoints (source(), target()), it supports the structured
+    bindings and opposite(v) is just the comparison with the source. Edges of the undirected graph are equal
+    when they have the same endpoints, edges of the directed graph only when they go in the same direction. Views and edges are valid until G is
+    modified, the same as the iterators of G.
+
+    Undirected edge is kept in the lists of both of its ends, edges() reports it from the end that comes
+    first: by operator< when node_type has it, otherwise by the position in G (one index lookup per edge end).
+*/
+
+#include "graph_lib_base.hpp"
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <assert.h>
+
+// edge of the graph, the references to its endpoints
+template <typename N, bool undirected>
+class graph_lib::edge
+{
+    N const * _source;
+    N const * _target;
+
+public:
+
+    edge(N const & source, N const & target) noexcept
+        : _source{&source}, _target{&target}
+    {
+    }
+
+    [[nodiscard]] auto source() const noexcept
+        -> N const &
+    {
+        return *_source;
+    }
+
+    [[nodiscard]] auto target() const noexcept
+        -> N const &
+    {
+        return *_target;
+    }
+
+    // returns the endpoint distinct from the vertex
+    // asserts that the vertex is one of the endpoints
+    [[nodiscard]] auto opposite(N const & vertex) const
+        -> N const &
+    {
+        assert(*_source == vertex || *_target == vertex);
+
+        return *_source == vertex ? *_target : *_source;
+    }
+
+    // undirected edges are compared by the endpoints, directed ones by the direction as well
+    [[nodiscard]] friend bool operator==(edge const & first, edge const & second)
+    {
+        return (*first._source == *second._source && *first._target == *second._target) ||
+               (undirected && *first._source == *second._target && *first._target == *second._source);
+    }
+
+    [[nodiscard]] friend bool operator!=(edge const & first, edge const & second)
+    {
+        return !(first == second);
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] auto get() const noexcept
+        -> N const &
+    {
+        static_assert(I < 2, "edge has two endpoints");
+        if constexpr (I == 0)
+        {
+            return source();
+        }
+        else
+        {
+            return target();
+        }
+    }
+};
+
+// edges can be decomposed by the structured bindings, auto [source, target] = e
+namespace std
+{
+    template <typename N, bool undirected>
+    struct tuple_size<graph_lib::edge<N, undirected>> : std::integral_constant<std::size_t, 2> {};
+
+    template <std::size_t I, typename N, bool undirected>
+    struct tuple_element<I, graph_lib::edge<N, undirected>>
+    {
+        using type = N const &;
+    };
+}
+
+namespace graph_lib::detail
+{
+    // pair of the iterators usable in the range-for and by the algorithms
+    template <typename Iterator>
+    class iterator_range
+    {
+        Iterator _first;
+        Iterator _last;
+
+    public:
+
+        using iterator_type = Iterator;
+
+        iterator_range(Iterator first, Iterator last) noexcept
+            : _first{first}, _last{last}
+        {
+        }
+
+        [[nodiscard]] auto begin() const noexcept
+            -> Iterator
+        {
+            return _first;
+        }
+
+        [[nodiscard]] auto end() const noexcept
+            -> Iterator
+        {
+            return _last;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return _first == _last;
+        }
+    };
+
+    template <typename T, typename = void>
+    struct is_less_comparable : std::false_type {};
+
+    template <typename T>
+    struct is_less_comparable<T, std::void_t<decltype(std::declval<T const &>() < std::declval<T const &>())>>
+        : std::true_type {};
+
+    // iterates over the vertices of the adjacency list, the first elements of its pairs
+    template <typename StorageIterator>
+    class vertex_iterator
+    {
+        StorageIterator _it;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename std::iterator_traits<StorageIterator>::value_type::first_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = value_type const *;
+        using reference         = value_type const &;
+
+        vertex_iterator() = default;
+
+        explicit vertex_iterator(StorageIterator it) noexcept
+            : _it{it}
+        {
+        }
+
+        [[nodiscard]] auto operator*() const noexcept
+            -> reference
+        {
+            return _it->first;
+        }
+
+        [[nodiscard]] auto operator->() const noexcept
+            -> pointer
+        {
+            return &_it->first;
+        }
+
+        auto operator++() noexcept
+            -> vertex_iterator &
+        {
+            ++_it;
+            return *this;
+        }
+
+        auto operator++(int) noexcept
+            -> vertex_iterator
+        {
+            auto previous = *this;
+            ++_it;
+            return previous;
+        }
+
+        [[nodiscard]] friend bool operator==(vertex_iterator const & first, vertex_iterator const & second) noexcept
+        {
+            return first._it == second._it;
+        }
+
+        [[nodiscard]] friend bool operator!=(vertex_iterator const & first, vertex_iterator const & second) noexcept
+        {
+            return first._it != second._it;
+        }
+    };
+
+    // iterates over the edges of one vertex, the edges are created on the fly
+    template <typename N, bool undirected>
+    class incident_edge_iterator
+    {
+        N const * _source;
+        N const * _target;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = edge<N, undirected>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = edge<N, undirected>;
+
+        incident_edge_iterator() = default;
+
+        incident_edge_iterator(N const * source, N const * target) noexcept
+            : _source{source}, _target{target}
+        {
+        }
+
+        [[nodiscard]] auto operator*() const noexcept
+            -> reference
+        {
+            return edge<N, undirected>{*_source, *_target};
+        }
+
+        auto operator++() noexcept
+            -> incident_edge_iterator &
+        {
+            ++_target;
+            return *this;
+        }
+
+        auto operator++(int) noexcept
+            -> incident_edge_iterator
+        {
+            auto previous = *this;
+            ++_target;
+            return previous;
+        }
+
+        [[nodiscard]] friend bool operator==(incident_edge_iterator const & first, incident_edge_iterator const & second) noexcept
+        {
+            return first._target == second._target;
+        }
+
+        [[nodiscard]] friend bool operator!=(incident_edge_iterator const & first, incident_edge_iterator const & second) noexcept
+        {
+            return first._target != second._target;
+        }
+    };
+
+    // iterates over the edges of the whole graph, list by list
+    // for the undirected graph only the end that comes first reports the edge
+    template <typename StorageIterator, typename VertexIndex, bool undirected>
+    class edge_iterator
+    {
+        using node_type = typename std::iterator_traits<StorageIterator>::value_type::first_type;
+
+        StorageIterator     _vertex;
+        StorageIterator     _last;
+        VertexIndex const * _index;
+        std::size_t         _slot;
+        // position in the list of _vertex, null at the end
+        node_type const *   _target;
+        node_type const *   _list_end;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = edge<node_type, undirected>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = edge<node_type, undirected>;
+
+        edge_iterator() = default;
+
+        // end iterator
+        explicit edge_iterator(StorageIterator last) noexcept
+            : _vertex{last}, _last{last}, _index{nullptr}, _slot{}, _target{nullptr}, _list_end{nullptr}
+        {
+        }
+
+        edge_iterator(StorageIterator first, StorageIterator last, VertexIndex const & index) noexcept
+            : _vertex{first}, _last{last}, _index{&index}, _slot{}, _target{nullptr}, _list_end{nullptr}
+        {
+            if (_vertex != _last)
+            {
+                enter_list();
+                settle();
+            }
+        }
+
+        [[nodiscard]] auto operator*() const noexcept
+            -> reference
+        {
+            return edge<node_type, undirected>{_vertex->first, *_target};
+        }
+
+        auto operator++()
+            -> edge_iterator &
+        {
+            ++_target;
+            settle();
+            return *this;
+        }
+
+        auto operator++(int)
+            -> edge_iterator
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        [[nodiscard]] friend bool operator==(edge_iterator const & first, edge_iterator const & second) noexcept
+        {
+            return first._vertex == second._vertex && first._target == second._target;
+        }
+
+        [[nodiscard]] friend bool operator!=(edge_iterator const & first, edge_iterator const & second) noexcept
+        {
+            return !(first == second);
+        }
+
+    private:
+
+        void enter_list() noexcept
+        {
+            auto const & list = _vertex->second.get();
+            _target   = list.data();
+            _list_end = _target + list.size();
+        }
+
+        // moves forward to the first edge that is reported, or to the end
+        void settle()
+        {
+            while (true)
+            {
+                for (; _target != _list_end; ++_target)
+                {
+                    if (reported(*_target))
+                    {
+                        return;
+                    }
+                }
+                ++_vertex;
+                ++_slot;
+                if (_vertex == _last)
+                {
+                    _target   = nullptr;
+                    _list_end = nullptr;
+                    return;
+                }
+                enter_list();
+            }
+        }
+
+        [[nodiscard]] bool reported(node_type const & target) const
+        {
+            if constexpr (undirected == false)
+            {
+                return true;
+            }
+            else if constexpr (is_less_comparable<node_type>::value)
+            {
+                return !(target < _vertex->first);
+            }
+            else
+            {
+                return _index->find(target)->second >= _slot;
+            }
+        }
+    };
+}
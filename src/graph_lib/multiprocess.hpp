@@ -0,0 +1,437 @@
+#pragma once
+
+/*
+    Running the algorithms on the parts of the graph (see partitioning.hpp) in separate worker processes
+    on the same host. Every worker gets its own address space and allocator, the processes communicate only
+    trough the named POSIX shared memory segments:
+
+        parent -> worker     part of the graph (owned and ghost vertices with their edges) and the degree queries
+        worker -> parent     triangles and the answered degree queries
+
+    run_partitioned(g, partition, queries)
+                             List the triangles of G and answer the degree queries, every part in its own process,
+                             returns nothing if some query vertex isn't in G, some segment couldn't be created
+                             or some worker failed
+
+    Results are merged without the duplicates by the ownership: the triangle is reported only by the part
+    that owns its vertex with the smallest slot, the degree only by the part that owns the vertex.
+    Part holds every neighbor of its owned vertices, so the triangles and the degrees are complete.
+
+    Segments hold the arrays of std::uint64_t, the input of the part is:
+
+        header       number of the vertices n, number of the queries q
+        vertices     n slots of the owned and the ghost vertices, in the increasing order
+        owned        n flags, 1 if the vertex is owned by the part
+        offsets      n + 1 offsets into the targets
+        targets      slots of the neighbors that are in the part, every list in the increasing order
+        queries      q slots of the owned vertices whose degree is asked for
+
+    and the output is the header (number of the triangles t, number of the degrees d),
+    followed by t triples of slots and d pairs (slot, degree).
+
+    Workers are forked, so they must not depend on the threads of the parent, the worker code doesn't use
+    the thread pool of the library.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "graph_lib_detail.hpp"
+#include "partitioning.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+template <typename V>
+struct graph_lib::partitioned_results
+{
+    // every triangle once, vertices and triangles in the order of the slots
+    std::vector<std::tuple<V,V,V>> triangles;
+    // degree of every queried vertex, in the order of the queries
+    std::vector<std::pair<V, std::size_t>> degrees;
+};
+
+namespace graph_lib::detail
+{
+    // named POSIX shared memory segment of the 64 bit words, mapped into the address space
+    // the creator unlinks the name when the segment is destroyed
+    class shared_segment
+    {
+        std::string     _name;
+        std::uint64_t * _data;
+        std::size_t     _words;
+        bool            _owner;
+
+    public:
+
+        shared_segment() noexcept
+            : _name{}, _data{nullptr}, _words{}, _owner{false}
+        {
+        }
+
+        shared_segment(shared_segment const &) = delete;
+        shared_segment & operator=(shared_segment const &) = delete;
+
+        shared_segment(shared_segment && other) noexcept
+            : _name{std::move(other._name)}, _data{other._data}, _words{other._words}, _owner{other._owner}
+        {
+            other._data  = nullptr;
+            other._owner = false;
+        }
+
+        ~shared_segment()
+        {
+            if (_data != nullptr)
+            {
+                ::munmap(_data, std::max<std::size_t>(_words, 1) * sizeof(std::uint64_t));
+            }
+            if (_owner)
+            {
+                ::shm_unlink(_name.c_str());
+            }
+        }
+
+        // creates the new segment of the given size, returns false if that failed
+        bool create(std::string name, std::size_t words)
+        {
+            _name = std::move(name);
+            auto const descriptor = ::shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (descriptor < 0)
+            {
+                return false;
+            }
+            _owner = true;
+
+            auto const bytes = std::max<std::size_t>(words, 1) * sizeof(std::uint64_t);
+            auto const sized = ::ftruncate(descriptor, static_cast<off_t>(bytes)) == 0;
+            return map(descriptor, sized, words);
+        }
+
+        // maps the existing segment, returns false if that failed
+        bool open(std::string name)
+        {
+            _name = std::move(name);
+            auto const descriptor = ::shm_open(_name.c_str(), O_RDWR, 0600);
+            if (descriptor < 0)
+            {
+                return false;
+            }
+
+            struct stat status{};
+            auto const known = ::fstat(descriptor, &status) == 0;
+            return map(descriptor, known, static_cast<std::size_t>(status.st_size) / sizeof(std::uint64_t));
+        }
+
+        // the name is unlinked by this object from now on
+        void adopt() noexcept
+        {
+            _owner = true;
+        }
+
+        // the name is left for the other process to unlink
+        void release() noexcept
+        {
+            _owner = false;
+        }
+
+        [[nodiscard]] auto data() const noexcept
+            -> std::uint64_t *
+        {
+            return _data;
+        }
+
+        [[nodiscard]] auto size() const noexcept
+            -> std::size_t
+        {
+            return _words;
+        }
+
+    private:
+
+        bool map(int descriptor, bool ready, std::size_t words)
+        {
+            if (ready)
+            {
+                auto * const address = ::mmap(nullptr, std::max<std::size_t>(words, 1) * sizeof(std::uint64_t),
+                                              PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+                if (address != MAP_FAILED)
+                {
+                    _data  = static_cast<std::uint64_t *>(address);
+                    _words = words;
+                }
+            }
+            ::close(descriptor);
+            return _data != nullptr;
+        }
+    };
+
+    // body of the worker process, reads the part from the input segment and writes the results
+    // into the newly created output segment, returns the exit code of the process
+    inline auto run_partition_worker(std::string const & input_name, std::string const & output_name)
+        -> int
+    {
+        shared_segment input{};
+        if (!input.open(input_name))
+        {
+            return 1;
+        }
+
+        auto const * const words = input.data();
+        std::size_t const vertices = words[0];
+        std::size_t const queries  = words[1];
+        auto const * const slots   = words + 2;
+        auto const * const owned   = slots + vertices;
+        auto const * const offsets = owned + vertices;
+        auto const * const targets = offsets + vertices + 1;
+        auto const * const asked   = targets + offsets[vertices];
+
+        auto const local = [&](std::uint64_t slot)
+        {
+            return static_cast<std::size_t>(std::lower_bound(slots, slots + vertices, slot) - slots);
+        };
+
+        // triangles u < v < w where u is owned, the third vertex is in both N(u) and N(v)
+        std::vector<std::uint64_t> triangles{};
+        for (std::size_t i = 0; i < vertices; ++i)
+        {
+            if (owned[i] == 0)
+            {
+                continue;
+            }
+
+            auto const u = slots[i];
+            auto const * const u_last = targets + offsets[i + 1];
+            for (auto const * v_it = std::upper_bound(targets + offsets[i], u_last, u); v_it != u_last; ++v_it)
+            {
+                auto const j = local(*v_it);
+                auto const * w_it = std::upper_bound(targets + offsets[j], targets + offsets[j + 1], *v_it);
+                auto const * const w_last = targets + offsets[j + 1];
+                auto const * x_it = v_it + 1;
+
+                while (x_it != u_last && w_it != w_last)
+                {
+                    if (*x_it < *w_it)
+                    {
+                        ++x_it;
+                    }
+                    else if (*w_it < *x_it)
+                    {
+                        ++w_it;
+                    }
+                    else
+                    {
+                        triangles.insert(std::end(triangles), {u, *v_it, *x_it});
+                        ++x_it;
+                        ++w_it;
+                    }
+                }
+            }
+        }
+
+        shared_segment output{};
+        if (!output.create(output_name, 2 + triangles.size() + 2 * queries))
+        {
+            return 1;
+        }
+        // the parent unlinks the output once it has read it
+        output.release();
+
+        auto * out = output.data();
+        *out++ = triangles.size() / 3;
+        *out++ = queries;
+        out = std::copy(std::cbegin(triangles), std::cend(triangles), out);
+        for (std::size_t q = 0; q < queries; ++q)
+        {
+            auto const j = local(asked[q]);
+            *out++ = asked[q];
+            *out++ = offsets[j + 1] - offsets[j];
+        }
+
+        return 0;
+    }
+}
+
+template <typename V, bool undirected>
+auto graph_lib::run_partitioned(graph<V,undirected> const & g, graph_partition<V> const & partition,
+                                std::vector<V> const & degree_queries)
+    -> std::optional<partitioned_results<V>>
+{
+    static_assert(undirected == true, "graph has to be undirected");
+
+    auto const adjacency = detail::make_compact_adjacency(g);
+    auto const parts = partition.num_parts();
+    assert(partition.part_of.size() == adjacency.num_vertices());
+
+    std::vector<V> vertices{};
+    vertices.reserve(g.num_vertices());
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        vertices.emplace_back(it->first);
+    }
+
+    // queries are checked before any worker starts, then routed to the owners of the vertices
+    auto const & index = g.vertex_index();
+    std::vector<std::size_t> query_slots{};
+    query_slots.reserve(degree_queries.size());
+    for (auto const & vertex : degree_queries)
+    {
+        auto const found = index.find(vertex);
+        if (found == std::cend(index))
+        {
+            return std::nullopt;
+        }
+        query_slots.emplace_back(found->second);
+    }
+
+    std::vector<std::vector<std::uint64_t>> routed(parts);
+    for (auto const slot : query_slots)
+    {
+        routed[partition.part_of[slot]].emplace_back(slot);
+    }
+
+    static std::atomic<std::size_t> calls{};
+    auto const prefix = "/graph_lib_" + std::to_string(::getpid()) + "_" + std::to_string(calls++) + "_";
+
+    // inputs
+    std::vector<detail::shared_segment> inputs(parts);
+    std::vector<std::size_t> local_of(adjacency.num_vertices());
+    for (std::size_t part = 0; part < parts; ++part)
+    {
+        std::vector<std::size_t> members{};
+        std::merge(std::cbegin(partition.owned[part]), std::cend(partition.owned[part]),
+                   std::cbegin(partition.ghosts[part]), std::cend(partition.ghosts[part]), std::back_inserter(members));
+
+        std::vector<char> inside(adjacency.num_vertices());
+        for (auto const slot : members)
+        {
+            inside[slot] = 1;
+        }
+
+        std::size_t edges{};
+        for (auto const slot : members)
+        {
+            for (auto i = adjacency.offsets[slot]; i < adjacency.offsets[slot + 1]; ++i)
+            {
+                if (inside[adjacency.targets[i]])
+                {
+                    ++edges;
+                }
+            }
+        }
+
+        auto const n = members.size();
+        if (!inputs[part].create(prefix + std::to_string(part) + "_in", 2 + 3 * n + 1 + edges + routed[part].size()))
+        {
+            return std::nullopt;
+        }
+
+        auto * const words   = inputs[part].data();
+        auto * const slots   = words + 2;
+        auto * const owned   = slots + n;
+        auto * const offsets = owned + n;
+        auto * const targets = offsets + n + 1;
+        words[0] = n;
+        words[1] = routed[part].size();
+
+        std::size_t position{};
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            auto const slot = members[i];
+            slots[i]   = slot;
+            owned[i]   = partition.part_of[slot] == part ? 1 : 0;
+            offsets[i] = position;
+
+            auto const first = targets + position;
+            for (auto j = adjacency.offsets[slot]; j < adjacency.offsets[slot + 1]; ++j)
+            {
+                if (inside[adjacency.targets[j]])
+                {
+                    targets[position++] = adjacency.targets[j];
+                }
+            }
+            std::sort(first, targets + position);
+        }
+        offsets[n] = position;
+        std::copy(std::cbegin(routed[part]), std::cend(routed[part]), targets + position);
+    }
+
+    // workers
+    std::vector<pid_t> workers{};
+    for (std::size_t part = 0; part < parts; ++part)
+    {
+        auto const worker = ::fork();
+        if (worker == 0)
+        {
+            ::_exit(detail::run_partition_worker(prefix + std::to_string(part) + "_in",
+                                                 prefix + std::to_string(part) + "_out"));
+        }
+        workers.emplace_back(worker);
+    }
+
+    bool succeeded = true;
+    for (auto const worker : workers)
+    {
+        int status{};
+        succeeded = worker > 0 && ::waitpid(worker, &status, 0) == worker
+                    && WIFEXITED(status) && WEXITSTATUS(status) == 0 && succeeded;
+    }
+
+    // outputs, opened even after a failure so that every created name gets unlinked
+    partitioned_results<V> results{};
+    std::vector<std::size_t> degree_of(adjacency.num_vertices());
+    std::vector<std::array<std::uint64_t, 3>> triangles{};
+
+    for (std::size_t part = 0; part < parts; ++part)
+    {
+        detail::shared_segment output{};
+        if (!output.open(prefix + std::to_string(part) + "_out"))
+        {
+            succeeded = false;
+            continue;
+        }
+        output.adopt();
+
+        auto const * words = output.data();
+        auto const count   = words[0];
+        auto const degrees = words[1];
+        words += 2;
+
+        for (std::uint64_t t = 0; t < count; ++t, words += 3)
+        {
+            triangles.push_back({words[0], words[1], words[2]});
+        }
+        for (std::uint64_t d = 0; d < degrees; ++d, words += 2)
+        {
+            degree_of[words[0]] = words[1];
+        }
+    }
+
+    if (!succeeded)
+    {
+        return std::nullopt;
+    }
+
+    std::sort(std::begin(triangles), std::end(triangles));
+    results.triangles.reserve(triangles.size());
+    for (auto const & [u, v, w] : triangles)
+    {
+        results.triangles.emplace_back(vertices[u], vertices[v], vertices[w]);
+    }
+
+    results.degrees.reserve(degree_queries.size());
+    for (std::size_t i = 0; i < degree_queries.size(); ++i)
+    {
+        results.degrees.emplace_back(degree_queries[i], degree_of[query_slots[i]]);
+    }
+
+    return results;
+}
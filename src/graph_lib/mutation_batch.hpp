@@ -0,0 +1,229 @@
+#pragma once
+
+/*
+    Batch of the modifications of the graph, recorded first and applied at once by graph::apply(batch).
+    Following functionalities are provided:
+
+    insert_vertex(v)         Record the insertion of the isolated vertex v
+    remove_vertex(v)         Record the removal of v and all of its edges
+    insert_edge(v,w)         Record the insertion of the edge between v and w
+    remove_edge(v,w)         Record the removal of the edge between v and w
+    size()                   Return the number of the recorded operations
+    empty()                  Return whether no operation was recorded
+    consistent()             Return whether the operations can follow each other, as far as the batch can tell
+                             without the graph (e.g. the vertex isn't inserted twice)
+    clear()                  Forget all of the operations
+
+    Operations mean the same as the member functions of graph.hpp called in the order they were recorded,
+    but the batch only keeps their net effect: the edge inserted and removed again (or removed and inserted
+    again) is left alone, the vertex inserted and removed again is never created and the edges recorded
+    for the vertex are dropped when the vertex is removed. For every vertex the batch keeps whether it has
+    to be in G before the batch, and the same for every edge between two vertices of G. graph::apply checks
+    these first and rejects the whole batch, leaving G untouched, if any of them doesn't hold.
+    Then G is changed in one pass:
+
+    drop the removed vertices from the lists of their neighbors;
+    compact the storage and the property columns once, without the removed vertices;
+    append the inserted vertices, in the order of their last insertion;
+    group the edge changes by the vertex whose list they change {
+        sort the slots of the removed neighbors;
+        filter the list once, looking every neighbor up in the sorted slots;
+        append the inserted neighbors;
+    }
+
+    NOTE: only the lists of the neighbors of the removed vertices are filtered (every list for the directed
+        graph) instead of every list for every removed vertex, and the vertex removed and the edge inserted
+        or removed only cost O(1) while they are recorded. Lists that don't change stay shared with
+        the snapshots. The edge removed and inserted again keeps its position and its property values,
+        unlike with the separate calls.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+template <typename V, bool undirected>
+class graph_lib::mutation_batch
+{
+public:
+
+    // aliases for convenience
+    using graph_type = graph<V,undirected>;
+    using node_type  = typename graph_type::node_type;
+
+private:
+
+    friend graph_type;
+
+    // net effect of the operations on the vertex
+    struct vertex_change
+    {
+        // whether the vertex has to be in G before the batch
+        bool          existed;
+        // whether the vertex is in G after the batch
+        bool          exists;
+        // number of the removals, the edges recorded before the last removal are dropped
+        std::uint32_t generation;
+        // number of the operation that inserted the vertex the last time
+        std::size_t   inserted;
+    };
+
+    // net effect of the operations on the edge
+    struct edge_change
+    {
+        node_type     first;
+        node_type     second;
+        bool          existed;
+        bool          exists;
+        // both ends were the vertices of G when the edge was recorded, only then G has to agree with existed
+        bool          original;
+        std::uint32_t first_generation;
+        std::uint32_t second_generation;
+    };
+
+    struct edge_key_hash
+    {
+        [[nodiscard]] auto operator()(std::pair<node_type, node_type> const & key) const
+            -> std::size_t
+        {
+            auto seed = std::hash<node_type>{}(key.first);
+            seed ^= std::hash<node_type>{}(key.second) + 0x9E3779B97F4A7C15 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
+    // member variables
+
+    std::unordered_map<node_type, vertex_change> _vertices;
+    // edges in the order they were first recorded, the edge recorded again after the removal of its end
+    // gets the new entry and the old one is kept only for the check against G
+    std::vector<edge_change> _edges;
+    std::unordered_map<std::pair<node_type, node_type>, std::size_t, edge_key_hash> _edge_index;
+    std::size_t _size;
+    bool        _consistent;
+
+public:
+
+    mutation_batch()
+        : _vertices{}, _edges{}, _edge_index{}, _size{}, _consistent{true}
+    {
+    }
+
+    void insert_vertex(V const & vertex)
+    {
+        ++_size;
+        auto & change = vertex_of(vertex, false);
+        _consistent = _consistent && !change.exists;
+        change.exists   = true;
+        change.inserted = _size;
+    }
+
+    void remove_vertex(V const & vertex)
+    {
+        ++_size;
+        auto & change = vertex_of(vertex, true);
+        _consistent = _consistent && change.exists;
+        change.exists = false;
+        ++change.generation;
+    }
+
+    void insert_edge(V const & first, V const & second)
+    {
+        ++_size;
+        auto & change = edge_of(first, second, false);
+        _consistent = _consistent && !change.exists;
+        change.exists = true;
+    }
+
+    void remove_edge(V const & first, V const & second)
+    {
+        ++_size;
+        auto & change = edge_of(first, second, true);
+        _consistent = _consistent && change.exists;
+        change.exists = false;
+    }
+
+    [[nodiscard]] auto size() const noexcept
+        -> std::size_t
+    {
+        return _size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    [[nodiscard]] bool consistent() const noexcept
+    {
+        return _consistent;
+    }
+
+    void clear()
+    {
+        _vertices.clear();
+        _edges.clear();
+        _edge_index.clear();
+        _size       = 0;
+        _consistent = true;
+    }
+
+private:
+
+    // returns the change of the vertex, the vertex seen for the first time is assumed to be in G or not
+    auto vertex_of(V const & vertex, bool existed)
+        -> vertex_change &
+    {
+        return _vertices.try_emplace(node_type{vertex}, vertex_change{existed, existed, 0, 0}).first->second;
+    }
+
+    // returns the change of the edge, the edge seen for the first time is assumed to be in G or not,
+    // the edge of the vertex that was inserted by the batch can't be in G
+    auto edge_of(V const & first, V const & second, bool existed)
+        -> edge_change &
+    {
+        auto const & first_change  = vertex_of(first, true);
+        auto const & second_change = vertex_of(second, true);
+        _consistent = _consistent && first_change.exists && second_change.exists;
+
+        auto found = _edge_index.find(std::pair{node_type{first}, node_type{second}});
+        if constexpr (undirected == true)
+        {
+            if (found == std::end(_edge_index))
+            {
+                found = _edge_index.find(std::pair{node_type{second}, node_type{first}});
+            }
+        }
+        if (found != std::end(_edge_index) && live(_edges[found->second]))
+        {
+            return _edges[found->second];
+        }
+
+        auto const original = first_change.existed && first_change.generation == 0 &&
+                              second_change.existed && second_change.generation == 0;
+        _consistent = _consistent && (original || !existed);
+
+        _edges.emplace_back(edge_change{node_type{first}, node_type{second}, existed && original, existed && original,
+                                        original, first_change.generation, second_change.generation});
+        if (found != std::end(_edge_index))
+        {
+            found->second = _edges.size() - 1;
+        }
+        else
+        {
+            _edge_index.emplace(std::pair{node_type{first}, node_type{second}}, _edges.size() - 1);
+        }
+        return _edges.back();
+    }
+
+    // checks whether neither of the ends was removed after the edge was recorded
+    [[nodiscard]] bool live(edge_change const & change) const
+    {
+        return _vertices.find(change.first)->second.generation == change.first_generation &&
+               _vertices.find(change.second)->second.generation == change.second_generation;
+    }
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+/*
+    Buffered writer used by the serializers in graph_io.hpp.
+    Output is collected in the large chunks and handed to the stream or to the file descriptor only
+    when enough of them is filled, for the file descriptor all of the chunks are written with a single writev.
+    Numbers are formatted with std::to_chars, without the locale and the formatting state of the streams.
+    Following functionalities are provided:
+
+    output_buffer(stream)    Write to the std::ostream
+    output_buffer(fd)        Write to the POSIX file descriptor, the descriptor isn't closed
+    put(c), write(s)         Append the character, the string
+    number(x)                Append the integral or the floating point number in the shortest form
+    value(v)                 Append the vertex: characters and strings as they are, numbers with number(x)
+    raw(x)                   Append the bytes of the trivially copyable value, in the byte order of the machine
+    flush()                  Write out everything that is buffered, returns false if any write so far failed
+
+    Buffer is flushed by the destructor as well, but then the failure can't be reported.
+*/
+
+#include "graph_lib_base.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <assert.h>
+#include <sys/uio.h>
+#include <limits.h>
+
+class graph_lib::output_buffer
+{
+    static constexpr std::size_t chunk_size = std::size_t{1} << 18;
+    static constexpr std::size_t max_chunks = 16;
+    // enough for any number that to_chars produces
+    static constexpr std::size_t max_number = 64;
+
+    struct chunk
+    {
+        std::unique_ptr<char[]> data;
+        std::size_t             used;
+    };
+
+    // member variables
+
+    std::ostream *     _stream;
+    int                _descriptor;
+    std::vector<chunk> _chunks;
+    bool               _failed;
+
+public:
+
+    explicit output_buffer(std::ostream & stream)
+        : _stream{&stream}, _descriptor{-1}, _chunks{}, _failed{false}
+    {
+    }
+
+    explicit output_buffer(int descriptor)
+        : _stream{nullptr}, _descriptor{descriptor}, _chunks{}, _failed{false}
+    {
+        assert(descriptor >= 0);
+    }
+
+    output_buffer(output_buffer const &) = delete;
+    output_buffer & operator=(output_buffer const &) = delete;
+
+    ~output_buffer()
+    {
+        flush();
+    }
+
+    void put(char character)
+    {
+        *room(1) = character;
+        commit(1);
+    }
+
+    void write(std::string_view text)
+    {
+        while (!text.empty())
+        {
+            auto const free = chunk_size - current_used();
+            auto const count = std::min(free == 0 ? chunk_size : free, text.size());
+            std::memcpy(room(count), text.data(), count);
+            commit(count);
+            text.remove_prefix(count);
+        }
+    }
+
+    template <typename T>
+    void number(T value)
+    {
+        static_assert(std::is_arithmetic_v<T>, "only numbers can be formatted");
+
+        auto * const first = room(max_number);
+        auto const [last, error] = std::to_chars(first, first + max_number, value);
+        assert(error == std::errc{});
+        (void) error;
+        commit(static_cast<std::size_t>(last - first));
+    }
+
+    template <typename V>
+    void value(V const & vertex)
+    {
+        if constexpr (std::is_same_v<V, char>)
+        {
+            put(vertex);
+        }
+        else if constexpr (std::is_convertible_v<V const &, std::string_view>)
+        {
+            write(vertex);
+        }
+        else
+        {
+            number(vertex);
+        }
+    }
+
+    template <typename T>
+    void raw(T const & value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be written as bytes");
+
+        std::memcpy(room(sizeof(T)), &value, sizeof(T));
+        commit(sizeof(T));
+    }
+
+    bool flush()
+    {
+        if (_descriptor >= 0)
+        {
+            flush_descriptor();
+        }
+        else
+        {
+            for (auto const & current : _chunks)
+            {
+                _stream->write(current.data.get(), static_cast<std::streamsize>(current.used));
+            }
+            _stream->flush();
+            _failed = _failed || !*_stream;
+        }
+
+        // the first chunk is kept for the next writes
+        _chunks.resize(std::min<std::size_t>(_chunks.size(), 1));
+        if (!_chunks.empty())
+        {
+            _chunks.front().used = 0;
+        }
+        return !_failed;
+    }
+
+private:
+
+    [[nodiscard]] auto current_used() const noexcept
+        -> std::size_t
+    {
+        return _chunks.empty() ? chunk_size : _chunks.back().used;
+    }
+
+    // returns the place for at least count bytes, count must not be larger than the chunk
+    [[nodiscard]] auto room(std::size_t count)
+        -> char *
+    {
+        if (chunk_size - current_used() < count)
+        {
+            if (_chunks.size() == max_chunks)
+            {
+                flush();
+            }
+            if (_chunks.empty() || _chunks.back().used != 0)
+            {
+                _chunks.emplace_back(chunk{std::make_unique<char[]>(chunk_size), 0});
+            }
+        }
+        return _chunks.back().data.get() + _chunks.back().used;
+    }
+
+    void commit(std::size_t count) noexcept
+    {
+        _chunks.back().used += count;
+    }
+
+    // writes all of the chunks with writev, partial writes continue from where they stopped
+    void flush_descriptor()
+    {
+        std::vector<iovec> vectors{};
+        for (auto const & current : _chunks)
+        {
+            if (current.used != 0)
+            {
+                vectors.emplace_back(iovec{current.data.get(), current.used});
+            }
+        }
+
+        std::size_t first{};
+        while (first < vectors.size() && !_failed)
+        {
+            auto const count = std::min<std::size_t>(vectors.size() - first, IOV_MAX);
+            auto written = ::writev(_descriptor, vectors.data() + first, static_cast<int>(count));
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written < 0)
+            {
+                _failed = true;
+                break;
+            }
+
+            for (auto left = static_cast<std::size_t>(written); left > 0 && first < vectors.size(); )
+            {
+                auto & current = vectors[first];
+                if (left >= current.iov_len)
+                {
+                    left -= current.iov_len;
+                    ++first;
+                }
+                else
+                {
+                    current.iov_base = static_cast<char *>(current.iov_base) + left;
+                    current.iov_len -= left;
+                    left = 0;
+                }
+            }
+        }
+    }
+};
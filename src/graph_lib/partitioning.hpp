@@ -0,0 +1,192 @@
+#pragma once
+
+/*
+    Splitting the graph into k parts of the (almost) same number of vertices, while cutting as few edges
+    as possible. Every part owns its vertices and additionally sees the ghost vertices: the neighbors of
+    its vertices that are owned by the other parts. Owned and ghost vertices together hold every edge
+    and every triangle that touches an owned vertex, so the part can be processed on its own.
+
+    partition_graph(g, k)    Split G into k parts, vertices are referred to by their slots
+                             (positions in the iteration order of G)
+
+    Pseudo code of the partitioning (BFS graph growing, followed by one pass of the boundary refinement):
+
+    target = ceil(|V| / k);
+    for each part p {
+        while p has less than target vertices (the last part takes the rest) {
+            if the queue Q is empty then
+                Q.push(first unassigned vertex); // new seed, G is disconnected or the part got stuck
+            v = Q.pop();
+            for each unassigned u in G.adjacentVertices(v)
+                assign u to p; Q.push(u);
+        }
+    }
+    for each vertex v {
+        b = part that holds the most neighbors of v;
+        if more neighbors of v are in b than in the part of v and b isn't overfull then
+            move v to b;
+    }
+
+    Growing the part in the breadth first order keeps it compact, so its boundary and the number
+    of cut edges stay small on the meshes, refinement then fixes the vertices left on the wrong side.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "graph_lib_detail.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <assert.h>
+
+template <typename V>
+struct graph_lib::graph_partition
+{
+    // part of every vertex, indexed by the slot
+    std::vector<std::size_t> part_of;
+    // slots of the vertices owned by every part, in the increasing order
+    std::vector<std::vector<std::size_t>> owned;
+    // slots of the ghost vertices of every part, in the increasing order
+    std::vector<std::vector<std::size_t>> ghosts;
+    // number of the edges whose endpoints are owned by the different parts
+    std::size_t cut_edges;
+
+    [[nodiscard]] auto num_parts() const noexcept
+        -> std::size_t
+    {
+        return owned.size();
+    }
+};
+
+template <typename V, bool undirected>
+auto graph_lib::partition_graph(graph<V,undirected> const & g, std::size_t parts)
+    -> graph_partition<V>
+{
+    static_assert(undirected == true, "graph has to be undirected");
+    assert(parts > 0);
+
+    auto const adjacency = detail::make_compact_adjacency(g);
+    auto const vertices  = adjacency.num_vertices();
+    auto const none      = std::numeric_limits<std::size_t>::max();
+    auto const target    = (vertices + parts - 1) / parts;
+
+    graph_partition<V> partition{std::vector<std::size_t>(vertices, none), {}, {}, 0};
+    auto & part_of = partition.part_of;
+    std::vector<std::size_t> sizes(parts);
+
+    // growing
+    std::vector<std::size_t> queue{};
+    queue.reserve(vertices);
+    std::size_t next_seed{};
+
+    for (std::size_t part = 0; part < parts; ++part)
+    {
+        auto const limit = (part + 1 == parts) ? vertices : std::min(vertices, target * (part + 1));
+        auto assigned = std::accumulate(std::cbegin(sizes), std::cend(sizes), std::size_t{});
+        std::size_t head{};
+        queue.clear();
+
+        auto const assign = [&](std::size_t slot)
+        {
+            part_of[slot] = part;
+            ++sizes[part];
+            ++assigned;
+            queue.emplace_back(slot);
+        };
+
+        while (assigned < limit)
+        {
+            if (head == queue.size())
+            {
+                while (part_of[next_seed] != none)
+                {
+                    ++next_seed;
+                }
+                assign(next_seed);
+                continue;
+            }
+
+            auto const v = queue[head++];
+            for (auto i = adjacency.offsets[v]; i < adjacency.offsets[v + 1] && assigned < limit; ++i)
+            {
+                if (part_of[adjacency.targets[i]] == none)
+                {
+                    assign(adjacency.targets[i]);
+                }
+            }
+        }
+    }
+
+    // refinement, parts may grow up to 3% over the target
+    auto const max_size = target + target / 32 + 1;
+    std::vector<std::size_t> counts(parts);
+    std::vector<std::size_t> touched{};
+
+    for (std::size_t v = 0; v < vertices; ++v)
+    {
+        touched.clear();
+        for (auto i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; ++i)
+        {
+            auto const part = part_of[adjacency.targets[i]];
+            if (counts[part]++ == 0)
+            {
+                touched.emplace_back(part);
+            }
+        }
+
+        auto const current = part_of[v];
+        auto best = current;
+        for (auto const part : touched)
+        {
+            if (counts[part] > counts[best])
+            {
+                best = part;
+            }
+        }
+
+        if (best != current && counts[best] > counts[current] && sizes[best] < max_size && sizes[current] > 1)
+        {
+            --sizes[current];
+            ++sizes[best];
+            part_of[v] = best;
+        }
+
+        for (auto const part : touched)
+        {
+            counts[part] = 0;
+        }
+    }
+
+    // owned and ghost vertices, cut edges
+    partition.owned.resize(parts);
+    partition.ghosts.resize(parts);
+    for (std::size_t v = 0; v < vertices; ++v)
+    {
+        partition.owned[part_of[v]].emplace_back(v);
+    }
+
+    std::vector<std::size_t> seen(vertices, none);
+    for (std::size_t part = 0; part < parts; ++part)
+    {
+        auto & ghosts = partition.ghosts[part];
+        for (auto const v : partition.owned[part])
+        {
+            for (auto i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; ++i)
+            {
+                auto const u = adjacency.targets[i];
+                if (part_of[u] != part && seen[u] != part)
+                {
+                    seen[u] = part;
+                    ghosts.emplace_back(u);
+                }
+                if (part_of[u] != part && v < u)
+                {
+                    ++partition.cut_edges;
+                }
+            }
+        }
+        std::sort(std::begin(ghosts), std::end(ghosts));
+    }
+
+    return partition;
+}
@@ -0,0 +1,1025 @@
+#pragma once
+
+/*
+    Validation of the polyhedral graphs.
+    By Steinitz's theorem a graph is the graph of a convex polyhedron if and only if it is
+    planar and 3-connected, every test here runs in O(V+E).
+    Following functionalities are provided:
+
+    find_planar_embedding(g) Return the rotation system of G, or nothing if G isn't planar
+    is_planar(g)             Return whether G is planar
+    is_biconnected(g)        Return whether G is connected and has no articulation points
+    is_polyhedral(g)         Return whether G is planar and 3-connected
+
+    NOTE: graphs are treated as simple, self loops and repeated edges are ignored.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "graph_lib_detail.hpp"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+
+namespace graph_lib::detail
+{
+    inline constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+    // simple undirected graph over the slots, every edge e has two half-edges
+    // half-edge 2e goes from endpoints[e][0] to endpoints[e][1], half-edge 2e+1 goes back
+    struct simple_graph
+    {
+        std::vector<std::array<std::size_t, 2>> endpoints;
+        // half-edges leaving the vertex v are halves[offsets[v]] ... halves[offsets[v+1] - 1]
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> halves;
+
+        [[nodiscard]] auto num_vertices() const noexcept -> std::size_t { return offsets.size() - 1; }
+        [[nodiscard]] auto num_edges() const noexcept -> std::size_t { return endpoints.size(); }
+        [[nodiscard]] auto degree(std::size_t v) const noexcept -> std::size_t { return offsets[v + 1] - offsets[v]; }
+        [[nodiscard]] auto origin(std::size_t h) const noexcept -> std::size_t { return endpoints[h / 2][h % 2]; }
+        [[nodiscard]] auto target(std::size_t h) const noexcept -> std::size_t { return endpoints[h / 2][1 - h % 2]; }
+    };
+
+    // drops self loops and repeated edges, edges are sorted with two passes of the counting sort
+    inline auto make_simple_graph(compact_adjacency const & adjacency)
+        -> simple_graph
+    {
+        auto const vertices = adjacency.num_vertices();
+
+        std::vector<std::array<std::size_t, 2>> pairs{};
+        pairs.reserve(std::size(adjacency.targets));
+        for (std::size_t v = 0; v < vertices; ++v)
+        {
+            for (auto i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; ++i)
+            {
+                auto const w = adjacency.targets[i];
+                if (w != v)
+                {
+                    pairs.emplace_back(std::array{std::min(v, w), std::max(v, w)});
+                }
+            }
+        }
+
+        std::vector<std::array<std::size_t, 2>> sorted(std::size(pairs));
+        std::vector<std::size_t> count(vertices + 1);
+        for (std::size_t const key : {std::size_t{1}, std::size_t{0}})
+        {
+            std::fill(std::begin(count), std::end(count), 0);
+            for (auto const & pair : pairs)
+            {
+                ++count[pair[key] + 1];
+            }
+            for (std::size_t v = 0; v < vertices; ++v)
+            {
+                count[v + 1] += count[v];
+            }
+            for (auto const & pair : pairs)
+            {
+                sorted[count[pair[key]]++] = pair;
+            }
+            std::swap(pairs, sorted);
+        }
+        pairs.erase(std::unique(std::begin(pairs), std::end(pairs)), std::end(pairs));
+
+        simple_graph g{};
+        g.endpoints = std::move(pairs);
+        g.offsets.assign(vertices + 1, 0);
+        for (auto const & [a, b] : g.endpoints)
+        {
+            ++g.offsets[a + 1];
+            ++g.offsets[b + 1];
+        }
+        for (std::size_t v = 0; v < vertices; ++v)
+        {
+            g.offsets[v + 1] += g.offsets[v];
+        }
+
+        g.halves.resize(g.offsets.back());
+        std::vector<std::size_t> position(std::cbegin(g.offsets), std::cend(g.offsets) - 1);
+        for (std::size_t e = 0; e < g.num_edges(); ++e)
+        {
+            g.halves[position[g.endpoints[e][0]]++] = 2 * e;
+            g.halves[position[g.endpoints[e][1]]++] = 2 * e + 1;
+        }
+
+        return g;
+    }
+
+    // checks that the graph is connected and has no articulation point, with the iterative
+    // version of the Tarjan's lowpoint depth first search
+    inline auto is_biconnected(simple_graph const & g)
+        -> bool
+    {
+        auto const vertices = g.num_vertices();
+        if (vertices < 2)
+        {
+            return false;
+        }
+
+        std::vector<std::size_t> discovery(vertices, none);
+        std::vector<std::size_t> low(vertices);
+        std::vector<std::size_t> parent_half(vertices, none);
+        std::vector<std::size_t> next(vertices);
+        std::vector<std::size_t> stack{0};
+
+        std::size_t time{};
+        std::size_t root_children{};
+        discovery[0] = low[0] = time++;
+
+        while (!stack.empty())
+        {
+            auto const v = stack.back();
+            if (next[v] < g.degree(v))
+            {
+                auto const h = g.halves[g.offsets[v] + next[v]++];
+                auto const w = g.target(h);
+                if (discovery[w] == none)
+                {
+                    discovery[w] = low[w] = time++;
+                    parent_half[w] = h;
+                    stack.emplace_back(w);
+                    root_children += (v == 0) ? 1 : 0;
+                }
+                else if ((h ^ 1) != parent_half[v])
+                {
+                    low[v] = std::min(low[v], discovery[w]);
+                }
+                continue;
+            }
+
+            stack.pop_back();
+            if (!stack.empty())
+            {
+                auto const u = stack.back();
+                low[u] = std::min(low[u], low[v]);
+                if (u != 0 && low[v] >= discovery[u])
+                {
+                    return false;
+                }
+            }
+        }
+
+        return time == vertices && root_children == 1;
+    }
+
+    /*
+    Left-right planarity test by de Fraysseix and Rosenstiehl, as described by Brandes
+    ("The Left-Right Planarity Test", 2009), with all of the depth first searches done iteratively.
+
+    1. orient G with a depth first search, compute lowpoints and the nesting depth of every edge
+    2. visit the out edges of every vertex ordered by the nesting depth, keep the stack of the
+       conflict pairs of return edges and fail as soon as two conflicting intervals can't be
+       put on different sides
+    3. resolve the sides of the edges, reorder the out edges by the signed nesting depth and
+       insert the back edges left or right of the tree edges to get the rotation system
+
+    Ordering by the nesting depth is a counting sort, since depths are bounded by 2V+1.
+    */
+    class lr_planarity
+    {
+    public:
+
+        explicit lr_planarity(simple_graph const & g)
+            : _g{g},
+              _height(g.num_vertices(), none), _parent_edge(g.num_vertices(), none), _roots{},
+              _source(g.num_edges()), _target(g.num_edges()),
+              _lowpt(g.num_edges()), _lowpt2(g.num_edges()), _nesting_depth(g.num_edges()),
+              _ordered_offsets{}, _ordered{},
+              _ref(g.num_edges(), none), _side(g.num_edges(), 1), _lowpt_edge(g.num_edges(), none),
+              _stack_bottom(g.num_edges()), _stack{},
+              _cw(2 * g.num_edges(), none), _ccw(2 * g.num_edges(), none), _first(g.num_vertices(), none),
+              _next(g.num_vertices()), _oriented(g.num_edges()), _skip_half(2 * g.num_edges()),
+              _skip_edge(g.num_edges()), _left_ref(g.num_vertices(), none), _right_ref(g.num_vertices(), none), _dfs{}
+        {
+        }
+
+        // runs the test, returns whether the graph is planar
+        // after the successful run, the rotation system is available through first and clockwise
+        [[nodiscard]] bool run()
+        {
+            auto const vertices = _g.num_vertices();
+            if (vertices > 2 && _g.num_edges() > 3 * vertices - 6)
+            {
+                return false;
+            }
+
+            for (std::size_t v = 0; v < vertices; ++v)
+            {
+                if (_height[v] == none)
+                {
+                    _height[v] = 0;
+                    _roots.emplace_back(v);
+                    orientation(v);
+                }
+            }
+
+            order_by_nesting_depth();
+
+            // every search reads the positions from the start again
+            std::fill(std::begin(_next), std::end(_next), 0);
+            for (auto const root : _roots)
+            {
+                if (!testing(root))
+                {
+                    return false;
+                }
+            }
+
+            for (std::size_t e = 0; e < _g.num_edges(); ++e)
+            {
+                _nesting_depth[e] *= sign(e);
+            }
+
+            order_by_nesting_depth();
+
+            for (std::size_t v = 0; v < vertices; ++v)
+            {
+                auto previous = none;
+                for (auto i = _ordered_offsets[v]; i < _ordered_offsets[v + 1]; ++i)
+                {
+                    auto const h = half_out(_ordered[i]);
+                    add_half_edge_cw(v, h, previous);
+                    previous = h;
+                }
+            }
+
+            std::fill(std::begin(_next), std::end(_next), 0);
+            for (auto const root : _roots)
+            {
+                embedding(root);
+            }
+
+            return true;
+        }
+
+        // first half-edge around the vertex, none for isolated vertices
+        [[nodiscard]] auto first(std::size_t v) const noexcept
+            -> std::size_t
+        {
+            return _first[v];
+        }
+
+        // next half-edge in the clockwise order around the origin of h
+        [[nodiscard]] auto clockwise(std::size_t h) const noexcept
+            -> std::size_t
+        {
+            return _cw[h];
+        }
+
+    private:
+
+        struct interval
+        {
+            std::size_t low{none};
+            std::size_t high{none};
+
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return low == none && high == none;
+            }
+        };
+
+        struct conflict_pair
+        {
+            interval left{};
+            interval right{};
+
+            void swap() noexcept
+            {
+                std::swap(left, right);
+            }
+        };
+
+        [[nodiscard]] auto half_out(std::size_t e) const noexcept
+            -> std::size_t
+        {
+            return 2 * e + ((_g.endpoints[e][0] == _source[e]) ? 0 : 1);
+        }
+
+        [[nodiscard]] auto half_in(std::size_t e) const noexcept
+            -> std::size_t
+        {
+            return half_out(e) ^ 1;
+        }
+
+        [[nodiscard]] bool conflicting(interval const & i, std::size_t b) const noexcept
+        {
+            return !i.empty() && _lowpt[i.high] > _lowpt[b];
+        }
+
+        [[nodiscard]] auto lowest(conflict_pair const & p) const noexcept
+            -> std::size_t
+        {
+            if (p.left.empty())
+            {
+                return _lowpt[p.right.low];
+            }
+            if (p.right.empty())
+            {
+                return _lowpt[p.left.low];
+            }
+            return std::min(_lowpt[p.left.low], _lowpt[p.right.low]);
+        }
+
+        // phase 1, orients the edges away from the root and computes the lowpoints
+        void orientation(std::size_t root)
+        {
+            auto & next      = _next;
+            auto & oriented  = _oriented;
+            auto & skip_init = _skip_half;
+            auto & stack     = _dfs;
+            stack.assign(1, root);
+
+            while (!stack.empty())
+            {
+                auto const v = stack.back();
+                stack.pop_back();
+                auto const e = _parent_edge[v];
+
+                while (next[v] < _g.degree(v))
+                {
+                    auto const h    = _g.halves[_g.offsets[v] + next[v]];
+                    auto const edge = h / 2;
+                    auto const w    = _g.target(h);
+
+                    if (!skip_init[h])
+                    {
+                        if (oriented[edge])
+                        {
+                            ++next[v];
+                            continue;
+                        }
+                        oriented[edge] = true;
+                        _source[edge] = v;
+                        _target[edge] = w;
+                        _lowpt[edge] = _lowpt2[edge] = _height[v];
+
+                        if (_height[w] == none)
+                        {
+                            // tree edge, visit w and come back to this edge afterwards
+                            _parent_edge[w] = edge;
+                            _height[w] = _height[v] + 1;
+                            skip_init[h] = true;
+                            stack.emplace_back(v);
+                            stack.emplace_back(w);
+                            break;
+                        }
+                        _lowpt[edge] = _height[w];
+                    }
+
+                    _nesting_depth[edge] = static_cast<std::int64_t>(2 * _lowpt[edge] + ((_lowpt2[edge] < _height[v]) ? 1 : 0));
+
+                    if (e != none)
+                    {
+                        if (_lowpt[edge] < _lowpt[e])
+                        {
+                            _lowpt2[e] = std::min(_lowpt[e], _lowpt2[edge]);
+                            _lowpt[e]  = _lowpt[edge];
+                        }
+                        else if (_lowpt[edge] > _lowpt[e])
+                        {
+                            _lowpt2[e] = std::min(_lowpt2[e], _lowpt[edge]);
+                        }
+                        else
+                        {
+                            _lowpt2[e] = std::min(_lowpt2[e], _lowpt2[edge]);
+                        }
+                    }
+                    ++next[v];
+                }
+            }
+        }
+
+        // groups the oriented edges by the source, inside the group edges are ordered by the nesting depth
+        void order_by_nesting_depth()
+        {
+            auto const vertices = _g.num_vertices();
+            auto const shift    = static_cast<std::int64_t>(2 * vertices + 1);
+
+            std::vector<std::size_t> count(2 * static_cast<std::size_t>(shift) + 2);
+            for (std::size_t e = 0; e < _g.num_edges(); ++e)
+            {
+                ++count[static_cast<std::size_t>(_nesting_depth[e] + shift) + 1];
+            }
+            for (std::size_t i = 1; i < std::size(count); ++i)
+            {
+                count[i] += count[i - 1];
+            }
+            std::vector<std::size_t> by_depth(_g.num_edges());
+            for (std::size_t e = 0; e < _g.num_edges(); ++e)
+            {
+                by_depth[count[static_cast<std::size_t>(_nesting_depth[e] + shift)]++] = e;
+            }
+
+            _ordered_offsets.assign(vertices + 1, 0);
+            for (std::size_t e = 0; e < _g.num_edges(); ++e)
+            {
+                ++_ordered_offsets[_source[e] + 1];
+            }
+            for (std::size_t v = 0; v < vertices; ++v)
+            {
+                _ordered_offsets[v + 1] += _ordered_offsets[v];
+            }
+            _ordered.resize(_g.num_edges());
+            std::vector<std::size_t> position(std::cbegin(_ordered_offsets), std::cend(_ordered_offsets) - 1);
+            for (auto const e : by_depth)
+            {
+                _ordered[position[_source[e]]++] = e;
+            }
+        }
+
+        // phase 2, checks the constraints between the return edges
+        [[nodiscard]] bool testing(std::size_t root)
+        {
+            auto & next      = _next;
+            auto & skip_init = _skip_edge;
+            auto & stack     = _dfs;
+            stack.assign(1, root);
+
+            while (!stack.empty())
+            {
+                auto const v = stack.back();
+                stack.pop_back();
+                auto const e = _parent_edge[v];
+                bool descended{false};
+
+                while (_ordered_offsets[v] + next[v] < _ordered_offsets[v + 1])
+                {
+                    auto const ei = _ordered[_ordered_offsets[v] + next[v]];
+                    auto const w  = _target[ei];
+
+                    if (!skip_init[ei])
+                    {
+                        _stack_bottom[ei] = std::size(_stack);
+                        if (ei == _parent_edge[w])
+                        {
+                            // tree edge, visit w and come back to this edge afterwards
+                            skip_init[ei] = true;
+                            stack.emplace_back(v);
+                            stack.emplace_back(w);
+                            descended = true;
+                            break;
+                        }
+                        _lowpt_edge[ei] = ei;
+                        _stack.emplace_back(conflict_pair{interval{}, interval{ei, ei}});
+                    }
+
+                    // integrate the new return edges
+                    if (_lowpt[ei] < _height[v])
+                    {
+                        if (ei == _ordered[_ordered_offsets[v]])
+                        {
+                            _lowpt_edge[e] = _lowpt_edge[ei];
+                        }
+                        else if (!add_constraints(ei, e))
+                        {
+                            return false;
+                        }
+                    }
+                    ++next[v];
+                }
+
+                if (!descended && e != none)
+                {
+                    remove_back_edges(e);
+                }
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool add_constraints(std::size_t ei, std::size_t e)
+        {
+            conflict_pair p{};
+
+            // merge the return edges of ei into p.right
+            do
+            {
+                auto q = _stack.back();
+                _stack.pop_back();
+                if (!q.left.empty())
+                {
+                    q.swap();
+                }
+                if (!q.left.empty())
+                {
+                    return false;
+                }
+                if (_lowpt[q.right.low] > _lowpt[e])
+                {
+                    if (p.right.empty())
+                    {
+                        p.right = q.right;
+                    }
+                    else
+                    {
+                        _ref[p.right.low] = q.right.high;
+                    }
+                    p.right.low = q.right.low;
+                }
+                else
+                {
+                    _ref[q.right.low] = _lowpt_edge[e];
+                }
+            } while (std::size(_stack) > _stack_bottom[ei]);
+
+            // merge the conflicting return edges of the previous siblings into p.left
+            while (!_stack.empty() && (conflicting(_stack.back().left, ei) || conflicting(_stack.back().right, ei)))
+            {
+                auto q = _stack.back();
+                _stack.pop_back();
+                if (conflicting(q.right, ei))
+                {
+                    q.swap();
+                }
+                if (conflicting(q.right, ei))
+                {
+                    return false;
+                }
+                if (p.right.low != none)
+                {
+                    _ref[p.right.low] = q.right.high;
+                }
+                if (q.right.low != none)
+                {
+                    p.right.low = q.right.low;
+                }
+                if (p.left.empty())
+                {
+                    p.left = q.left;
+                }
+                else
+                {
+                    _ref[p.left.low] = q.left.high;
+                }
+                p.left.low = q.left.low;
+            }
+
+            if (!(p.left.empty() && p.right.empty()))
+            {
+                _stack.emplace_back(p);
+            }
+            return true;
+        }
+
+        void remove_back_edges(std::size_t e)
+        {
+            auto const u = _source[e];
+
+            // drop the whole conflict pairs returning to u
+            while (!_stack.empty() && lowest(_stack.back()) == _height[u])
+            {
+                auto const p = _stack.back();
+                _stack.pop_back();
+                if (p.left.low != none)
+                {
+                    _side[p.left.low] = -1;
+                }
+            }
+
+            // one more conflict pair to trim
+            if (!_stack.empty())
+            {
+                auto p = _stack.back();
+                _stack.pop_back();
+
+                while (p.left.high != none && _target[p.left.high] == u)
+                {
+                    p.left.high = _ref[p.left.high];
+                }
+                if (p.left.high == none && p.left.low != none)
+                {
+                    _ref[p.left.low]  = p.right.low;
+                    _side[p.left.low] = -1;
+                    p.left.low        = none;
+                }
+
+                while (p.right.high != none && _target[p.right.high] == u)
+                {
+                    p.right.high = _ref[p.right.high];
+                }
+                if (p.right.high == none && p.right.low != none)
+                {
+                    _ref[p.right.low]  = p.left.low;
+                    _side[p.right.low] = -1;
+                    p.right.low        = none;
+                }
+
+                _stack.emplace_back(p);
+            }
+
+            // side of e is the side of its highest return edge
+            if (_lowpt[e] < _height[u] && !_stack.empty())
+            {
+                auto const high_left  = _stack.back().left.high;
+                auto const high_right = _stack.back().right.high;
+
+                if (high_left != none && (high_right == none || _lowpt[high_left] > _lowpt[high_right]))
+                {
+                    _ref[e] = high_left;
+                }
+                else
+                {
+                    _ref[e] = high_right;
+                }
+            }
+        }
+
+        // side of the edge relative to the chain of its references, references are resolved on the way
+        [[nodiscard]] auto sign(std::size_t e)
+            -> std::int64_t
+        {
+            std::vector<std::size_t> chain{};
+            auto x = e;
+            while (_ref[x] != none)
+            {
+                chain.emplace_back(x);
+                x = _ref[x];
+            }
+            for (auto it = std::rbegin(chain); it != std::rend(chain); ++it)
+            {
+                _side[*it] *= _side[_ref[*it]];
+                _ref[*it] = none;
+            }
+            return _side[e];
+        }
+
+        void add_half_edge_cw(std::size_t start, std::size_t h, std::size_t reference)
+        {
+            if (reference == none)
+            {
+                _cw[h] = _ccw[h] = h;
+                _first[start] = h;
+                return;
+            }
+            auto const next = _cw[reference];
+            _cw[reference] = h;
+            _ccw[h]        = reference;
+            _cw[h]         = next;
+            _ccw[next]     = h;
+        }
+
+        void add_half_edge_ccw(std::size_t start, std::size_t h, std::size_t reference)
+        {
+            if (reference == none)
+            {
+                add_half_edge_cw(start, h, none);
+                return;
+            }
+            add_half_edge_cw(start, h, _ccw[reference]);
+            if (reference == _first[start])
+            {
+                _first[start] = h;
+            }
+        }
+
+        // phase 3, inserts the incoming half-edges into the rotation system
+        void embedding(std::size_t root)
+        {
+            auto & left_ref  = _left_ref;
+            auto & right_ref = _right_ref;
+            auto & next      = _next;
+            auto & stack     = _dfs;
+            stack.assign(1, root);
+
+            while (!stack.empty())
+            {
+                auto const v = stack.back();
+                stack.pop_back();
+
+                while (_ordered_offsets[v] + next[v] < _ordered_offsets[v + 1])
+                {
+                    auto const ei = _ordered[_ordered_offsets[v] + next[v]++];
+                    auto const w  = _target[ei];
+
+                    if (ei == _parent_edge[w])
+                    {
+                        add_half_edge_ccw(w, half_in(ei), _first[w]);
+                        left_ref[v] = right_ref[v] = half_out(ei);
+                        stack.emplace_back(v);
+                        stack.emplace_back(w);
+                        break;
+                    }
+                    if (_side[ei] == 1)
+                    {
+                        add_half_edge_cw(w, half_in(ei), right_ref[w]);
+                    }
+                    else
+                    {
+                        add_half_edge_ccw(w, half_in(ei), left_ref[w]);
+                        left_ref[w] = half_in(ei);
+                    }
+                }
+            }
+        }
+
+        simple_graph const & _g;
+
+        std::vector<std::size_t>  _height;
+        std::vector<std::size_t>  _parent_edge;
+        std::vector<std::size_t>  _roots;
+
+        std::vector<std::size_t>  _source;
+        std::vector<std::size_t>  _target;
+        std::vector<std::size_t>  _lowpt;
+        std::vector<std::size_t>  _lowpt2;
+        std::vector<std::int64_t> _nesting_depth;
+
+        std::vector<std::size_t>  _ordered_offsets;
+        std::vector<std::size_t>  _ordered;
+
+        std::vector<std::size_t>  _ref;
+        std::vector<std::int64_t> _side;
+        std::vector<std::size_t>  _lowpt_edge;
+        std::vector<std::size_t>  _stack_bottom;
+        std::vector<conflict_pair> _stack;
+
+        std::vector<std::size_t>  _cw;
+        std::vector<std::size_t>  _ccw;
+        std::vector<std::size_t>  _first;
+
+        // scratch of the depth first searches, allocated once for all of the roots
+        // the searches from different roots touch disjoint vertices and edges, so the entries
+        // are never reset between the roots, only _next is cleared before every phase
+        std::vector<std::size_t>  _next;
+        std::vector<bool>         _oriented;
+        std::vector<bool>         _skip_half;
+        std::vector<bool>         _skip_edge;
+        std::vector<std::size_t>  _left_ref;
+        std::vector<std::size_t>  _right_ref;
+        std::vector<std::size_t>  _dfs;
+    };
+
+    /*
+    A 2-connected plane graph with at least 4 vertices is 3-connected if and only if every two
+    faces meet in nothing, in a single vertex or in a single edge.
+
+    Two faces f and g sharing vertices u and v make a 4-cycle u-f-v-g in the vertex-face incidence
+    graph R, so the condition says that every 4-cycle of R goes around an edge uv with f and g on
+    its two sides. R is planar, so all of its 4-cycles are found in linear time with the
+    Chiba-Nishizeki algorithm: vertices of R are visited by decreasing degree, for every visited
+    x all paths x-y-z through unvisited y and z are collected per z, and x is removed afterwards.
+    */
+    inline auto faces_meet_properly(simple_graph const & g, lr_planarity const & embedding)
+        -> bool
+    {
+        auto const vertices = g.num_vertices();
+        auto const halves   = 2 * g.num_edges();
+
+        // the face on the right side of the half-edge, walking u->v continues with the half-edge
+        // that follows v->u clockwise around v
+        std::vector<std::size_t> face_of(halves, none);
+        std::size_t faces{};
+        for (std::size_t h = 0; h < halves; ++h)
+        {
+            if (face_of[h] != none)
+            {
+                continue;
+            }
+            for (auto current = h; face_of[current] == none; current = embedding.clockwise(current ^ 1))
+            {
+                face_of[current] = faces;
+            }
+            ++faces;
+        }
+
+        // Euler's formula for the connected plane graph
+        if (vertices + faces != g.num_edges() + 2)
+        {
+            return false;
+        }
+
+        // incidence graph R, vertices of G keep their slots and faces follow them
+        auto const nodes = vertices + faces;
+        std::vector<std::size_t> offsets(nodes + 1);
+        for (std::size_t h = 0; h < halves; ++h)
+        {
+            ++offsets[g.origin(h) + 1];
+            ++offsets[vertices + face_of[h] + 1];
+        }
+        for (std::size_t x = 0; x < nodes; ++x)
+        {
+            offsets[x + 1] += offsets[x];
+        }
+        std::vector<std::size_t> incidence(offsets.back());
+        std::vector<std::size_t> position(std::cbegin(offsets), std::cend(offsets) - 1);
+        for (std::size_t h = 0; h < halves; ++h)
+        {
+            incidence[position[g.origin(h)]++] = vertices + face_of[h];
+            incidence[position[vertices + face_of[h]]++] = g.origin(h);
+        }
+
+        // in a 2-connected plane graph faces are cycles, so a face can't pass twice through a vertex
+        for (std::size_t x = 0; x < nodes; ++x)
+        {
+            auto const first = std::begin(incidence) + static_cast<std::ptrdiff_t>(offsets[x]);
+            auto const last  = std::begin(incidence) + static_cast<std::ptrdiff_t>(offsets[x + 1]);
+            std::sort(first, last);
+            if (std::adjacent_find(first, last) != last)
+            {
+                return false;
+            }
+        }
+
+        std::unordered_map<std::size_t, std::size_t> edge_of{};
+        edge_of.reserve(g.num_edges());
+        for (std::size_t e = 0; e < g.num_edges(); ++e)
+        {
+            edge_of.emplace(g.endpoints[e][0] * vertices + g.endpoints[e][1], e);
+        }
+
+        // 4-cycle u-f-v-g is fine only if uv is an edge with faces f and g on its sides
+        auto const around_edge = [&](std::size_t u, std::size_t v, std::size_t f, std::size_t h)
+        {
+            auto const found = edge_of.find(std::min(u, v) * vertices + std::max(u, v));
+            if (found == std::cend(edge_of))
+            {
+                return false;
+            }
+            auto const a = vertices + face_of[2 * found->second];
+            auto const b = vertices + face_of[2 * found->second + 1];
+            return (a == f && b == h) || (a == h && b == f);
+        };
+
+        std::vector<std::size_t> order(nodes);
+        {
+            std::vector<std::size_t> count(nodes + 1);
+            for (std::size_t x = 0; x < nodes; ++x)
+            {
+                ++count[nodes - (offsets[x + 1] - offsets[x])];
+            }
+            for (std::size_t i = 1; i <= nodes; ++i)
+            {
+                count[i] += count[i - 1];
+            }
+            for (auto x = nodes; x-- > 0;)
+            {
+                order[--count[nodes - (offsets[x + 1] - offsets[x])]] = x;
+            }
+        }
+
+        std::vector<bool> removed(nodes);
+        std::vector<std::vector<std::size_t>> paths(nodes);
+        std::vector<std::size_t> touched{};
+
+        for (auto const x : order)
+        {
+            for (auto i = offsets[x]; i < offsets[x + 1]; ++i)
+            {
+                auto const y = incidence[i];
+                if (removed[y])
+                {
+                    continue;
+                }
+                for (auto j = offsets[y]; j < offsets[y + 1]; ++j)
+                {
+                    auto const z = incidence[j];
+                    if (z == x || removed[z])
+                    {
+                        continue;
+                    }
+                    if (paths[z].empty())
+                    {
+                        touched.emplace_back(z);
+                    }
+                    paths[z].emplace_back(y);
+                }
+            }
+
+            for (auto const z : touched)
+            {
+                auto const & middle = paths[z];
+                if (std::size(middle) > 2)
+                {
+                    return false;
+                }
+                if (std::size(middle) == 2)
+                {
+                    auto const ok = (x < vertices) ? around_edge(x, z, middle[0], middle[1])
+                                                   : around_edge(middle[0], middle[1], x, z);
+                    if (!ok)
+                    {
+                        return false;
+                    }
+                }
+                paths[z].clear();
+            }
+            touched.clear();
+            removed[x] = true;
+        }
+
+        return true;
+    }
+}
+
+/*
+Planar embedding
+
+Let E be the rotation system of G found by the left-right planarity test;
+for each vertex v in G.vertices() {
+    E.insertLast((v, neighbors of v in the clockwise order));
+}
+return E
+
+NOTE: vertices keep the order they have in G, only the neighbors are reordered
+*/
+template <typename V, bool undirected>
+auto graph_lib::find_planar_embedding(graph<V,undirected> const & g)
+    -> std::optional<typename graph<V,undirected>::graph_vector_type>
+{
+    static_assert(undirected, "planarity is defined for undirected graphs");
+
+    auto const simple = detail::make_simple_graph(detail::make_compact_adjacency(g));
+    detail::lr_planarity planarity{simple};
+
+    if (!planarity.run())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<typename graph<V,undirected>::node_type const *> vertices{};
+    vertices.reserve(g.num_vertices());
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        vertices.emplace_back(&it->first);
+    }
+
+    typename graph<V,undirected>::graph_vector_type ret_val{};
+    ret_val.reserve(g.num_vertices());
+    for (std::size_t v = 0; v < std::size(vertices); ++v)
+    {
+        typename graph<V,undirected>::edges_vector_type neighbors{};
+        neighbors.reserve(simple.degree(v));
+
+        auto const first = planarity.first(v);
+        if (first != detail::none)
+        {
+            auto h = first;
+            do
+            {
+                neighbors.emplace_back(*vertices[simple.target(h)]);
+                h = planarity.clockwise(h);
+            } while (h != first);
+        }
+        ret_val.emplace_back(std::pair{*vertices[v], std::move(neighbors)});
+    }
+
+    return ret_val;
+}
+
+template <typename V, bool undirected>
+auto graph_lib::is_planar(graph<V,undirected> const & g)
+    -> bool
+{
+    static_assert(undirected, "planarity is defined for undirected graphs");
+
+    auto const simple = detail::make_simple_graph(detail::make_compact_adjacency(g));
+    return detail::lr_planarity{simple}.run();
+}
+
+template <typename V, bool undirected>
+auto graph_lib::is_biconnected(graph<V,undirected> const & g)
+    -> bool
+{
+    static_assert(undirected, "biconnectivity is defined for undirected graphs");
+
+    return detail::is_biconnected(detail::make_simple_graph(detail::make_compact_adjacency(g)));
+}
+
+/*
+Polyhedral graph check (Steinitz)
+
+if G has less than 4 vertices or G isn't 2-connected then
+    return false
+if G isn't planar then
+    return false
+return every two faces of the embedding of G meet in nothing, a vertex or an edge
+*/
+template <typename V, bool undirected>
+auto graph_lib::is_polyhedral(graph<V,undirected> const & g)
+    -> bool
+{
+    static_assert(undirected, "polyhedral graphs are undirected");
+
+    if (g.num_vertices() < 4)
+    {
+        return false;
+    }
+
+    auto const simple = detail::make_simple_graph(detail::make_compact_adjacency(g));
+    if (!detail::is_biconnected(simple))
+    {
+        return false;
+    }
+
+    detail::lr_planarity planarity{simple};
+    if (!planarity.run())
+    {
+        return false;
+    }
+
+    return detail::faces_meet_properly(simple, planarity);
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+/*
+    Cache of the results of the algorithms, for the services that run the same algorithms on the graphs
+    that rarely change. Results are kept by (graph id, algorithm, parameters) together with the version of
+    the graph they were computed for (see id() and version() of graph.hpp), so the result is reused only
+    while the graph wasn't modified, and the stale result is replaced by the new one on the next call.
+    Following functionalities are provided:
+
+    result_cache(limit)                          Cache that holds at most limit bytes of the results
+    find_orders_of_vertices(g)                   Cached graph_lib::find_orders_of_vertices(g)
+    find_triangular_faces(g)                     Cached graph_lib::find_triangular_faces(g)
+    find_all_connected_vertices_of_the_same_degree(g, d)
+                                                 Cached graph_lib::find_all_connected_vertices_of_the_same_degree(g, d)
+    get(g, algorithm, parameters, compute)       Cached compute() for any other algorithm, results of the same
+                                                 algorithm and parameters have to be of the same type
+    statistics()                                 Return the hits, misses, evictions and the memory held
+    clear()                                      Drop all of the results, the statistics are kept
+
+    Results are returned as the shared pointers to the constant results, so the hit takes O(1) and
+    the result stays valid even if it is evicted later. The least recently used results are evicted
+    when the results take more than the limit, the result larger than the limit isn't cached at all.
+    Memory of the result is estimated from the capacity of the vector (or from the size of any other type).
+
+    Cache can be used from many threads, compute() is called without the lock held, so two threads that
+    miss at the same time both compute the result and the later one is kept.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "graph_algorithms.hpp"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+struct graph_lib::cache_statistics
+{
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t evictions;
+    // number of the cached results and the bytes they take
+    std::size_t entries;
+    std::size_t memory_used;
+};
+
+namespace graph_lib::detail
+{
+    // estimated bytes held by the result
+    template <typename T>
+    auto result_bytes(T const &) noexcept
+        -> std::size_t
+    {
+        return sizeof(T);
+    }
+
+    template <typename T>
+    auto result_bytes(std::vector<T> const & result) noexcept
+        -> std::size_t
+    {
+        return sizeof(result) + result.capacity() * sizeof(T);
+    }
+}
+
+class graph_lib::result_cache
+{
+    struct key_type
+    {
+        std::uint64_t graph;
+        std::string   algorithm;
+        std::string   parameters;
+
+        [[nodiscard]] friend bool operator==(key_type const & first, key_type const & second)
+        {
+            return first.graph == second.graph && first.algorithm == second.algorithm && first.parameters == second.parameters;
+        }
+    };
+
+    struct key_hash
+    {
+        [[nodiscard]] auto operator()(key_type const & key) const noexcept
+            -> std::size_t
+        {
+            auto seed = std::hash<std::uint64_t>{}(key.graph);
+            for (auto const & part : {key.algorithm, key.parameters})
+            {
+                seed ^= std::hash<std::string>{}(part) + 0x9E3779B97F4A7C15 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+
+    struct entry
+    {
+        key_type              key;
+        std::uint64_t         version;
+        std::shared_ptr<void const> result;
+        std::size_t           bytes;
+    };
+
+    // member variables
+
+    std::size_t      _memory_limit;
+    // the most recently used entry is at the front
+    std::list<entry> _entries;
+    std::unordered_map<key_type, std::list<entry>::iterator, key_hash> _index;
+    cache_statistics _statistics;
+    mutable std::mutex _mutex;
+
+public:
+
+    explicit result_cache(std::size_t memory_limit)
+        : _memory_limit{memory_limit}, _entries{}, _index{}, _statistics{}, _mutex{}
+    {
+    }
+
+    result_cache(result_cache const &) = delete;
+    result_cache & operator=(result_cache const &) = delete;
+
+    template <typename V, bool undirected>
+    auto find_orders_of_vertices(graph<V,undirected> const & g)
+        -> std::shared_ptr<std::vector<std::pair<V, typename graph<V,undirected>::edges_size_type>> const>
+    {
+        return get(g, "find_orders_of_vertices", {}, [&]{ return graph_lib::find_orders_of_vertices(g); });
+    }
+
+    template <typename V, bool undirected>
+    auto find_triangular_faces(graph<V,undirected> const & g)
+        -> std::shared_ptr<std::vector<std::tuple<V,V,V>> const>
+    {
+        return get(g, "find_triangular_faces", {}, [&]{ return graph_lib::find_triangular_faces(g); });
+    }
+
+    template <typename V, bool undirected>
+    auto find_all_connected_vertices_of_the_same_degree(graph<V,undirected> const & g,
+                                                        typename graph<V,undirected>::edges_size_type const & degree)
+        -> std::shared_ptr<std::vector<std::pair<V,V>> const>
+    {
+        return get(g, "find_all_connected_vertices_of_the_same_degree", std::to_string(degree),
+                   [&]{ return graph_lib::find_all_connected_vertices_of_the_same_degree(g, degree); });
+    }
+
+    // returns the cached result of the algorithm with the parameters for the current version of the graph,
+    // computes and caches it if there is none
+    template <typename V, bool undirected, typename Compute>
+    auto get(graph<V,undirected> const & g, std::string algorithm, std::string parameters, Compute && compute)
+        -> std::shared_ptr<std::invoke_result_t<Compute> const>
+    {
+        using result_type = std::invoke_result_t<Compute>;
+
+        key_type key{g.id(), std::move(algorithm), std::move(parameters)};
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+
+            auto const found = _index.find(key);
+            if (found != std::end(_index) && found->second->version == g.version())
+            {
+                ++_statistics.hits;
+                _entries.splice(std::begin(_entries), _entries, found->second);
+                return std::static_pointer_cast<result_type const>(found->second->result);
+            }
+            ++_statistics.misses;
+        }
+
+        auto result = std::make_shared<result_type const>(std::forward<Compute>(compute)());
+        auto const bytes = detail::result_bytes(*result);
+
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (auto const found = _index.find(key); found != std::end(_index))
+        {
+            erase(found->second);
+        }
+        if (bytes <= _memory_limit)
+        {
+            _entries.push_front(entry{key, g.version(), result, bytes});
+            _index.emplace(std::move(key), std::begin(_entries));
+            _statistics.memory_used += bytes;
+            ++_statistics.entries;
+
+            while (_statistics.memory_used > _memory_limit)
+            {
+                erase(std::prev(std::end(_entries)));
+                ++_statistics.evictions;
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] auto statistics() const
+        -> cache_statistics
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        return _statistics;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _index.clear();
+        _entries.clear();
+        _statistics.entries     = 0;
+        _statistics.memory_used = 0;
+    }
+
+private:
+
+    // the lock has to be held
+    void erase(std::list<entry>::iterator it)
+    {
+        _statistics.memory_used -= it->bytes;
+        --_statistics.entries;
+        _index.erase(it->key);
+        _entries.erase(it);
+    }
+};
@@ -0,0 +1,380 @@
+#pragma once
+
+/*
+    Induced subgraph of the graph, presented lazily. Nothing of G is copied, the view only keeps one flag
+    per vertex of G and skips the vertices and the neighbors without the flag while they are iterated.
+    Following functionalities are provided:
+
+    induced_subgraph(g, mask)    View of the vertices of G whose flag is set, mask is in the order of the vertices of G
+    induced_subgraph(g, keep)    View of the vertices v of G where keep(v) is true, keep is called once per vertex
+    num_vertices()               Return the number of vertices in the view
+    num_edges()                  Return the number of edges between the vertices of the view, counted in O(E)
+    contains(v)                  Return whether v is a vertex of the view
+    degree(v)                    Return the number of neighbors of v inside the view
+    adjacent_vertices(v)         Return the view of the neighbors of v inside the view
+    are_adjacent(v,w)            Return whether v and w are both in the view and adjacent in G
+    vertices()                   Return the view of the vertices, in the order of G
+    cbegin(), cend()             Iterate trough the (vertex, neighbors) pairs, just like the iterators of G
+
+    Algorithms that take the view (see graph_algorithms.hpp and triangle_counting.hpp) build the same
+    compact adjacency they build for G, so they run on the view without materializing it as the graph.
+    Checking the flag of the neighbor takes one lookup in the vertex index of G.
+    View is valid until G is modified, the same as the iterators of G.
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "graph_views.hpp"
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <assert.h>
+
+namespace graph_lib::detail
+{
+    // iterates over the neighbors whose flag is set
+    template <typename N, typename VertexIndex>
+    class filtered_neighbor_iterator
+    {
+        N const *                 _it;
+        N const *                 _end;
+        VertexIndex const *       _index;
+        std::vector<char> const * _mask;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = N;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = N const *;
+        using reference         = N const &;
+
+        filtered_neighbor_iterator() = default;
+
+        filtered_neighbor_iterator(N const * it, N const * end, VertexIndex const & index, std::vector<char> const & mask)
+            : _it{it}, _end{end}, _index{&index}, _mask{&mask}
+        {
+            settle();
+        }
+
+        [[nodiscard]] auto operator*() const noexcept
+            -> reference
+        {
+            return *_it;
+        }
+
+        [[nodiscard]] auto operator->() const noexcept
+            -> pointer
+        {
+            return _it;
+        }
+
+        auto operator++()
+            -> filtered_neighbor_iterator &
+        {
+            ++_it;
+            settle();
+            return *this;
+        }
+
+        auto operator++(int)
+            -> filtered_neighbor_iterator
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        [[nodiscard]] friend bool operator==(filtered_neighbor_iterator const & first, filtered_neighbor_iterator const & second) noexcept
+        {
+            return first._it == second._it;
+        }
+
+        [[nodiscard]] friend bool operator!=(filtered_neighbor_iterator const & first, filtered_neighbor_iterator const & second) noexcept
+        {
+            return first._it != second._it;
+        }
+
+    private:
+
+        void settle()
+        {
+            while (_it != _end && !(*_mask)[_index->find(*_it)->second])
+            {
+                ++_it;
+            }
+        }
+    };
+
+    // neighbors of the vertex inside the view, the size is counted on every call
+    template <typename Iterator>
+    class filtered_range : public iterator_range<Iterator>
+    {
+    public:
+
+        using iterator_range<Iterator>::iterator_range;
+
+        [[nodiscard]] auto size() const
+            -> std::size_t
+        {
+            return static_cast<std::size_t>(std::distance(this->begin(), this->end()));
+        }
+    };
+
+    // vertex of the view with its neighbors, in the shape of the elements of the adjacency list
+    template <typename N, typename Neighbors>
+    struct subgraph_entry
+    {
+        using first_type = N;
+
+        N const & first;
+        Neighbors second;
+    };
+
+    // result of operator-> of the iterators that create their elements on the fly
+    template <typename T>
+    struct arrow_proxy
+    {
+        T value;
+
+        [[nodiscard]] auto operator->() const noexcept
+            -> T const *
+        {
+            return &value;
+        }
+    };
+
+    // iterates over the vertices of the adjacency list whose flag is set
+    template <typename StorageIterator, typename VertexIndex>
+    class subgraph_iterator
+    {
+        using node_type = typename std::iterator_traits<StorageIterator>::value_type::first_type;
+
+        StorageIterator           _it;
+        StorageIterator           _last;
+        std::size_t               _slot;
+        VertexIndex const *       _index;
+        std::vector<char> const * _mask;
+
+    public:
+
+        using neighbor_iterator = filtered_neighbor_iterator<node_type, VertexIndex>;
+        using neighbor_range    = filtered_range<neighbor_iterator>;
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = subgraph_entry<node_type, neighbor_range>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = arrow_proxy<value_type>;
+        using reference         = value_type;
+
+        subgraph_iterator() = default;
+
+        subgraph_iterator(StorageIterator first, StorageIterator last, std::size_t slot,
+                          VertexIndex const & index, std::vector<char> const & mask)
+            : _it{first}, _last{last}, _slot{slot}, _index{&index}, _mask{&mask}
+        {
+            settle();
+        }
+
+        [[nodiscard]] auto operator*() const
+            -> reference
+        {
+            auto const & list = _it->second.get();
+            auto const * const begin = list.data();
+            auto const * const end   = begin + list.size();
+            return value_type{_it->first, neighbor_range{neighbor_iterator{begin, end, *_index, *_mask},
+                                                         neighbor_iterator{end, end, *_index, *_mask}}};
+        }
+
+        [[nodiscard]] auto operator->() const
+            -> pointer
+        {
+            return pointer{**this};
+        }
+
+        auto operator++() noexcept
+            -> subgraph_iterator &
+        {
+            ++_it;
+            ++_slot;
+            settle();
+            return *this;
+        }
+
+        auto operator++(int) noexcept
+            -> subgraph_iterator
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        [[nodiscard]] friend bool operator==(subgraph_iterator const & first, subgraph_iterator const & second) noexcept
+        {
+            return first._it == second._it;
+        }
+
+        [[nodiscard]] friend bool operator!=(subgraph_iterator const & first, subgraph_iterator const & second) noexcept
+        {
+            return first._it != second._it;
+        }
+
+    private:
+
+        void settle() noexcept
+        {
+            while (_it != _last && !(*_mask)[_slot])
+            {
+                ++_it;
+                ++_slot;
+            }
+        }
+    };
+}
+
+template <typename V, bool undirected>
+class graph_lib::induced_subgraph
+{
+public:
+
+    // aliases for convenience
+    using graph_type         = graph<V,undirected>;
+    using node_type          = typename graph_type::node_type;
+    using vertices_size_type = typename graph_type::vertices_size_type;
+    using edges_size_type    = typename graph_type::edges_size_type;
+    using const_iterator     = detail::subgraph_iterator<typename graph_type::storage_type::const_iterator,
+                                                         typename graph_type::vertex_index_type>;
+    using neighbor_range     = typename const_iterator::neighbor_range;
+    using vertex_range       = detail::iterator_range<detail::vertex_iterator<const_iterator>>;
+
+private:
+
+    // member variables
+
+    graph_type const * _graph;
+    // flag of every vertex of the graph, indexed by the slot
+    std::vector<char>  _mask;
+    vertices_size_type _num_vertices;
+
+public:
+
+    // view of the vertices whose flag is set, the mask has one flag for every vertex of the graph
+    induced_subgraph(graph<V,undirected> const & g, std::vector<char> mask)
+        : _graph{&g}, _mask{std::move(mask)}, _num_vertices{}
+    {
+        assert(_mask.size() == g.num_vertices());
+
+        _num_vertices = static_cast<vertices_size_type>(std::count_if(std::cbegin(_mask), std::cend(_mask),
+                                                                      [](char flag){ return flag != 0; }));
+    }
+
+    // view of the vertices where keep(vertex) is true, the predicate is evaluated once for every vertex
+    template <typename Predicate,
+              typename = std::enable_if_t<std::is_invocable_r_v<bool, Predicate &, node_type const &>>>
+    induced_subgraph(graph<V,undirected> const & g, Predicate && keep)
+        : induced_subgraph{g, make_mask(g, keep)}
+    {
+    }
+
+    // the view refers to the graph, so it can't be made for the temporary
+    induced_subgraph(graph<V,undirected> &&, std::vector<char>) = delete;
+
+    template <typename Predicate,
+              typename = std::enable_if_t<std::is_invocable_r_v<bool, Predicate &, node_type const &>>>
+    induced_subgraph(graph<V,undirected> &&, Predicate &&) = delete;
+
+    [[nodiscard]] auto cbegin() const
+        -> const_iterator
+    {
+        return const_iterator{_graph->cbegin(), _graph->cend(), 0, _graph->vertex_index(), _mask};
+    }
+
+    [[nodiscard]] auto cend() const
+        -> const_iterator
+    {
+        return const_iterator{_graph->cend(), _graph->cend(), _mask.size(), _graph->vertex_index(), _mask};
+    }
+
+    // returns the view of the vertices, in the order of the graph
+    [[nodiscard]] auto vertices() const
+        -> vertex_range
+    {
+        using iterator = typename vertex_range::iterator_type;
+        return vertex_range{iterator{cbegin()}, iterator{cend()}};
+    }
+
+    // returns the number of vertices in the view
+    [[nodiscard]] auto num_vertices() const noexcept
+        -> vertices_size_type
+    {
+        return _num_vertices;
+    }
+
+    // returns the number of edges between the vertices of the view, every list is filtered again
+    [[nodiscard]] auto num_edges() const
+        -> edges_size_type
+    {
+        edges_size_type ends{};
+        for (auto it = cbegin(); it != cend(); ++it)
+        {
+            ends += std::size(it->second);
+        }
+        return undirected ? ends / 2 : ends;
+    }
+
+    // returns whether the vertex is in the view
+    [[nodiscard]] bool contains(V const & vertex) const
+    {
+        auto const & index = _graph->vertex_index();
+        auto const found = index.find(node_type{vertex});
+
+        return found != std::cend(index) && _mask[found->second];
+    }
+
+    // returns the number of neighbors of the vertex inside the view
+    // asserts whether the view contains that vertex
+    [[nodiscard]] auto degree(V const & vertex) const
+        -> edges_size_type
+    {
+        return adjacent_vertices(vertex).size();
+    }
+
+    // returns the view of the neighbors of the vertex inside the view
+    // asserts whether the view contains that vertex
+    [[nodiscard]] auto adjacent_vertices(V const & vertex) const
+        -> neighbor_range
+    {
+        assert(contains(vertex));
+
+        auto const & index = _graph->vertex_index();
+        auto const & list  = _graph->adjacent_vertices(vertex);
+        auto const * const begin = list.data();
+        auto const * const end   = begin + list.size();
+
+        using iterator = typename neighbor_range::iterator_type;
+        return neighbor_range{iterator{begin, end, index, _mask}, iterator{end, end, index, _mask}};
+    }
+
+    // checks whether both of the vertices are in the view and adjacent
+    [[nodiscard]] bool are_adjacent(V const & node_a, V const & node_b) const
+    {
+        return contains(node_a) && contains(node_b) && _graph->are_adjacent(node_a, node_b);
+    }
+
+private:
+
+    template <typename Predicate>
+    [[nodiscard]] static auto make_mask(graph_type const & g, Predicate & keep)
+        -> std::vector<char>
+    {
+        std::vector<char> mask{};
+        mask.reserve(g.num_vertices());
+        for (auto it = g.cbegin(); it != g.cend(); ++it)
+        {
+            mask.emplace_back(keep(it->first) ? char{1} : char{0});
+        }
+        return mask;
+    }
+};
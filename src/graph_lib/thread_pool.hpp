@@ -0,0 +1,163 @@
+#pragma once
+
+/*
+    Thread pool shared by all of the parallel algorithms of the library, so the threads are
+    started once instead of on every call.
+
+    instance()               Return the pool of the library, started on the first use
+    size()                   Return the number of threads that run the tasks, including the caller
+    run(n, fn)               Call fn(i) for every i in [0, n) on the pool, returns when all calls are done
+
+    The thread that calls run() takes the tasks of its own job as well, so run() can be called
+    from inside of the task without a deadlock, in the worst case the caller runs every task itself.
+    Tasks must not throw.
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace graph_lib::detail
+{
+    class thread_pool
+    {
+        struct job
+        {
+            std::function<void(std::size_t)> task;
+            std::size_t                      count;
+            std::atomic<std::size_t>         next{};
+            std::atomic<std::size_t>         done{};
+        };
+
+        std::mutex                        _mutex;
+        std::condition_variable           _wake;
+        std::condition_variable           _finished;
+        std::deque<std::shared_ptr<job>>  _jobs;
+        std::vector<std::thread>          _workers;
+        bool                              _stopping;
+
+    public:
+
+        explicit thread_pool(std::size_t workers)
+            : _mutex{}, _wake{}, _finished{}, _jobs{}, _workers{}, _stopping{false}
+        {
+            _workers.reserve(workers);
+            for (std::size_t i = 0; i < workers; ++i)
+            {
+                _workers.emplace_back([this]{ work(); });
+            }
+        }
+
+        thread_pool(thread_pool const &) = delete;
+        thread_pool & operator=(thread_pool const &) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                _stopping = true;
+            }
+            _wake.notify_all();
+
+            for (auto & worker : _workers)
+            {
+                worker.join();
+            }
+        }
+
+        // at least one worker is started, so the parallel paths are taken even on a single core
+        [[nodiscard]] static auto instance()
+            -> thread_pool &
+        {
+            static thread_pool pool{std::max<std::size_t>(2, std::thread::hardware_concurrency()) - 1};
+            return pool;
+        }
+
+        [[nodiscard]] auto size() const noexcept
+            -> std::size_t
+        {
+            return _workers.size() + 1;
+        }
+
+        template <typename F>
+        void run(std::size_t count, F && fn)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            if (count == 1)
+            {
+                fn(std::size_t{0});
+                return;
+            }
+
+            auto current = std::make_shared<job>();
+            current->task  = std::ref(fn);
+            current->count = count;
+
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                _jobs.emplace_back(current);
+            }
+            _wake.notify_all();
+
+            drain(*current);
+
+            std::unique_lock<std::mutex> lock{_mutex};
+            _finished.wait(lock, [&]{ return current->done.load() == count; });
+            _jobs.erase(std::remove(std::begin(_jobs), std::end(_jobs), current), std::end(_jobs));
+        }
+
+    private:
+
+        // takes the tasks of the job until there are none left
+        void drain(job & current)
+        {
+            for (auto i = current.next++; i < current.count; i = current.next++)
+            {
+                current.task(i);
+                if (++current.done == current.count)
+                {
+                    // taking the lock makes sure that the waiting caller can't miss the notification
+                    std::lock_guard<std::mutex> lock{_mutex};
+                    _finished.notify_all();
+                }
+            }
+        }
+
+        void work()
+        {
+            while (true)
+            {
+                std::shared_ptr<job> current{};
+                {
+                    std::unique_lock<std::mutex> lock{_mutex};
+                    _wake.wait(lock, [&]
+                    {
+                        // jobs whose tasks are all taken are dropped, their callers wait for the rest
+                        while (!_jobs.empty() && _jobs.front()->next.load() >= _jobs.front()->count)
+                        {
+                            _jobs.pop_front();
+                        }
+                        return _stopping || !_jobs.empty();
+                    });
+
+                    if (_jobs.empty())
+                    {
+                        return;
+                    }
+                    current = _jobs.front();
+                }
+                drain(*current);
+            }
+        }
+    };
+}
@@ -0,0 +1,461 @@
+#pragma once
+
+/*
+    Counting the triangles without listing them.
+    Every triangle (3-cycle) is counted exactly once, the same triangles find_triangles reports.
+    Following functionalities are provided:
+
+    count_triangles(g)                   Return the exact number of the triangles of G, nothing is allocated
+                                         (for the induced subgraph the compact adjacency of the view is built)
+    estimate_triangles_doulion(g, o)     Estimate the number of the triangles by the edge sampling (DOULION)
+    estimate_triangles_wedge(g, o)       Estimate the number of the triangles by the wedge sampling
+
+    Estimates come with the confidence interval, see triangle_estimate and sampling_options.
+    The sample is either given by its size, or it grows until the interval is narrow enough.
+
+    Exact count, every vertex is ranked by (degree, slot) and the triangle is counted from its lowest ranked vertex:
+
+    for each vertex u in G.vertices() {
+        for each pair v, w in G.adjacentVertices(u) with rank(v) > rank(u) and rank(w) > rank(u)
+            if G.areAdjacent(v, w) then
+                count++;
+    }
+
+    Lists of the low ranked vertices are short, so the pairs stay few even around the hubs.
+
+    DOULION, repeated r times so the spread of the repetitions gives the interval:
+
+    keep every edge of G with the probability p, independently;
+    t = exact count of the triangles made of the kept edges;
+    estimate = t / p^3;
+
+    Wedge sampling, wedge is the path v - u - w with the center u, G has W = sum of C(degree(u), 2) wedges:
+
+    for k times {
+        pick the wedge uniformly (center by its number of wedges, then two distinct neighbors);
+        if the wedge is closed (v and w are adjacent) then closed++;
+    }
+    estimate = closed / k * W / 3; // every triangle closes three wedges
+*/
+
+#include "graph_lib_base.hpp"
+#include "graph.hpp"
+#include "compressed_graph.hpp"
+#include "subgraph_view.hpp"
+#include "graph_lib_detail.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <assert.h>
+
+struct graph_lib::triangle_estimate
+{
+    // estimated number of the triangles
+    double estimate;
+    // confidence interval of the estimate
+    double lower;
+    double upper;
+    // number of the sampled edges (DOULION) or wedges
+    std::size_t samples;
+};
+
+struct graph_lib::sampling_options
+{
+    // number of the samples, when 0 the sample grows until the relative error is reached
+    // with too small sample no triangle may be found, the estimate and the interval are then [0, 0]
+    std::size_t sample_size = 0;
+    // target half width of the interval relative to the estimate
+    double relative_error = 0.05;
+    // probability that the interval holds the exact count
+    double confidence = 0.95;
+    // the same seed gives the same estimate
+    std::uint64_t seed = 0x9E3779B97F4A7C15;
+};
+
+namespace graph_lib::detail
+{
+    // independent repetitions of DOULION, the interval is the normal approximation over them
+    inline constexpr std::size_t doulion_repetitions = 32;
+    // wedges are sampled in the batches of this size, until the relative error is reached
+    inline constexpr std::size_t wedge_batch = 4096;
+    // the sample never grows over this size, even if the relative error isn't reached
+    inline constexpr std::size_t max_samples = std::size_t{1} << 26;
+
+    // z such that the standard normal variable lies in [-z, z] with the given probability
+    inline auto normal_quantile(double confidence)
+        -> double
+    {
+        assert(confidence > 0.0 && confidence < 1.0);
+
+        double low{0.0}, high{40.0};
+        for (int i = 0; i < 100; ++i)
+        {
+            auto const middle = (low + high) / 2;
+            (std::erf(middle / std::sqrt(2.0)) < confidence ? low : high) = middle;
+        }
+        return high;
+    }
+
+    // edges of G oriented from the lower to the higher rank (degree, slot), vertices are replaced by the ranks
+    // out-lists are sorted, so the edges are sorted by (source, target)
+    inline auto make_oriented_edges(compact_adjacency const & adjacency)
+        -> std::vector<std::pair<std::size_t, std::size_t>>
+    {
+        auto const vertices = adjacency.num_vertices();
+        std::vector<std::size_t> order(vertices);
+        std::iota(std::begin(order), std::end(order), std::size_t{});
+        std::stable_sort(std::begin(order), std::end(order),
+                         [&](std::size_t first, std::size_t second){ return adjacency.degree(first) < adjacency.degree(second); });
+
+        std::vector<std::size_t> rank_of(vertices);
+        for (std::size_t rank = 0; rank < vertices; ++rank)
+        {
+            rank_of[order[rank]] = rank;
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> edges{};
+        edges.reserve(adjacency.targets.size() / 2);
+        for (std::size_t rank = 0; rank < vertices; ++rank)
+        {
+            auto const slot  = order[rank];
+            auto const first = edges.size();
+            for (auto i = adjacency.offsets[slot]; i < adjacency.offsets[slot + 1]; ++i)
+            {
+                if (rank_of[adjacency.targets[i]] > rank)
+                {
+                    edges.emplace_back(rank, rank_of[adjacency.targets[i]]);
+                }
+            }
+            std::sort(std::begin(edges) + static_cast<std::ptrdiff_t>(first), std::end(edges));
+        }
+        return edges;
+    }
+
+    // counts the triangles of the sorted oriented edges, the pairs of every out-list are looked up by the binary search
+    inline auto count_oriented_triangles(std::vector<std::pair<std::size_t, std::size_t>> const & edges)
+        -> std::size_t
+    {
+        std::size_t count{};
+        for (std::size_t begin = 0, end = 0; begin < edges.size(); begin = end)
+        {
+            while (end < edges.size() && edges[end].first == edges[begin].first)
+            {
+                ++end;
+            }
+            for (auto i = begin; i < end; ++i)
+            {
+                for (auto j = i + 1; j < end; ++j)
+                {
+                    if (std::binary_search(std::cbegin(edges), std::cend(edges), std::pair{edges[i].second, edges[j].second}))
+                    {
+                        ++count;
+                    }
+                }
+            }
+        }
+        return count;
+    }
+
+    // DOULION with the fixed probability, every repetition keeps the edges by the geometric skips
+    inline auto doulion(std::vector<std::pair<std::size_t, std::size_t>> const & edges, double probability,
+                        double z, std::mt19937_64 & generator)
+        -> triangle_estimate
+    {
+        if (probability >= 1.0)
+        {
+            auto const exact = static_cast<double>(count_oriented_triangles(edges));
+            return triangle_estimate{exact, exact, exact, edges.size()};
+        }
+
+        std::geometric_distribution<std::size_t> skip{probability};
+        std::vector<std::pair<std::size_t, std::size_t>> kept{};
+        std::vector<double> estimates{};
+        std::size_t samples{};
+
+        for (std::size_t repetition = 0; repetition < doulion_repetitions; ++repetition)
+        {
+            kept.clear();
+            for (auto i = skip(generator); i < edges.size(); i += skip(generator) + 1)
+            {
+                kept.emplace_back(edges[i]);
+            }
+            samples += kept.size();
+            estimates.emplace_back(static_cast<double>(count_oriented_triangles(kept)) / (probability * probability * probability));
+        }
+
+        auto const repetitions = static_cast<double>(doulion_repetitions);
+        auto const mean = std::accumulate(std::cbegin(estimates), std::cend(estimates), 0.0) / repetitions;
+        auto squares = 0.0;
+        for (auto const estimate : estimates)
+        {
+            squares += (estimate - mean) * (estimate - mean);
+        }
+        auto const half_width = z * std::sqrt(squares / (repetitions - 1) / repetitions);
+
+        return triangle_estimate{mean, std::max(0.0, mean - half_width), mean + half_width, samples};
+    }
+
+    // Wilson score interval of the fraction of the closed wedges, scaled to the number of the triangles
+    inline auto wedge_estimate(std::size_t closed, std::size_t samples, double wedges, double z)
+        -> triangle_estimate
+    {
+        auto const k        = static_cast<double>(samples);
+        auto const fraction = static_cast<double>(closed) / k;
+        auto const shrink   = 1.0 + z * z / k;
+        auto const center   = (fraction + z * z / (2 * k)) / shrink;
+        auto const half     = z / shrink * std::sqrt(fraction * (1 - fraction) / k + z * z / (4 * k * k));
+        auto const scale    = wedges / 3;
+
+        return triangle_estimate{fraction * scale, std::max(0.0, center - half) * scale,
+                                 std::min(1.0, center + half) * scale, samples};
+    }
+
+    [[nodiscard]] inline bool precise_enough(triangle_estimate const & estimate, double relative_error) noexcept
+    {
+        return (estimate.upper - estimate.lower) / 2 <= relative_error * estimate.estimate;
+    }
+}
+
+template <typename V, bool undirected>
+auto graph_lib::count_triangles(graph<V,undirected> const & g)
+    -> std::size_t
+{
+    static_assert(undirected == true, "graph has to be undirected");
+
+    if (g.num_vertices() == 0)
+    {
+        return 0;
+    }
+
+    auto const & index = g.vertex_index();
+    auto const * const vertices = &*g.cbegin();
+
+    // slot and rank of the vertex, the rank is (degree, slot)
+    auto const locate = [&](auto const & vertex)
+    {
+        auto const found = index.find(vertex);
+        assert(found != std::cend(index));
+        return std::pair{std::size(vertices[found->second].second), found->second};
+    };
+
+    std::size_t count{};
+    for (std::size_t u = 0; u < g.num_vertices(); ++u)
+    {
+        auto const & edges = vertices[u].second;
+        auto const u_rank = std::pair{std::size(edges), u};
+
+        for (auto v_it = std::cbegin(edges); v_it != std::cend(edges); ++v_it)
+        {
+            auto const v_rank = locate(*v_it);
+            if (v_rank < u_rank)
+            {
+                continue;
+            }
+
+            for (auto w_it = std::next(v_it); w_it != std::cend(edges); ++w_it)
+            {
+                auto const w_rank = locate(*w_it);
+                if (w_rank < u_rank)
+                {
+                    continue;
+                }
+
+                // the shorter of the two lists is searched
+                auto const * list   = &vertices[v_rank.second].second;
+                auto const * target = &*w_it;
+                if (w_rank.first < v_rank.first)
+                {
+                    list   = &vertices[w_rank.second].second;
+                    target = &*v_it;
+                }
+                if (std::find(std::cbegin(*list), std::cend(*list), *target) != std::cend(*list))
+                {
+                    ++count;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// same as above on the compressed graph, the sorted lists are intersected by merging the two decoders
+template <typename V>
+auto graph_lib::count_triangles(compressed_graph<V, true> const & g)
+    -> std::size_t
+{
+    using id_type = typename compressed_graph<V, true>::id_type;
+
+    std::size_t count{};
+    for (id_type u = 0; u < g.num_vertices(); ++u)
+    {
+        auto const u_neighbors = g.adjacent_ids(u);
+
+        for (auto v_it = u_neighbors.begin(); v_it != u_neighbors.end(); ++v_it)
+        {
+            auto const v = *v_it;
+            if (v <= u)
+            {
+                continue;
+            }
+
+            auto first = std::next(v_it);
+            auto const v_neighbors = g.adjacent_ids(v);
+            auto second = v_neighbors.begin();
+
+            while (first != u_neighbors.end() && second != v_neighbors.end())
+            {
+                if (*second <= v || *second < *first)
+                {
+                    ++second;
+                }
+                else if (*first < *second)
+                {
+                    ++first;
+                }
+                else
+                {
+                    ++count;
+                    ++first;
+                    ++second;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// same as above on the induced subgraph, the edges of the view are oriented from the lower ranked end
+// and the oriented lists are intersected, see detail::make_oriented_edges
+template <typename V, bool undirected>
+auto graph_lib::count_triangles(induced_subgraph<V,undirected> const & g)
+    -> std::size_t
+{
+    static_assert(undirected == true, "graph has to be undirected");
+
+    return detail::count_oriented_triangles(detail::make_oriented_edges(detail::make_compact_adjacency(g)));
+}
+
+template <typename V, bool undirected>
+auto graph_lib::estimate_triangles_doulion(graph<V,undirected> const & g, sampling_options const & options)
+    -> triangle_estimate
+{
+    static_assert(undirected == true, "graph has to be undirected");
+    assert(options.sample_size > 0 || options.relative_error > 0.0);
+
+    auto const edges = detail::make_oriented_edges(detail::make_compact_adjacency(g));
+    auto const z = detail::normal_quantile(options.confidence);
+    std::mt19937_64 generator{options.seed};
+
+    if (edges.empty())
+    {
+        return triangle_estimate{0.0, 0.0, 0.0, 0};
+    }
+
+    auto const total = static_cast<double>(edges.size());
+    if (options.sample_size > 0)
+    {
+        auto const probability = static_cast<double>(options.sample_size) / static_cast<double>(detail::doulion_repetitions) / total;
+        return detail::doulion(edges, std::min(1.0, probability), z, generator);
+    }
+
+    // the probability doubles until the interval is narrow enough, with p = 1 the count is exact
+    auto probability = 1.0 / 16;
+    std::size_t samples{};
+    while (true)
+    {
+        auto estimate = detail::doulion(edges, probability, z, generator);
+        samples += estimate.samples;
+        if (probability >= 1.0 || (estimate.estimate > 0.0 && detail::precise_enough(estimate, options.relative_error)))
+        {
+            estimate.samples = samples;
+            return estimate;
+        }
+        probability = std::min(1.0, probability * 2);
+    }
+}
+
+template <typename V, bool undirected>
+auto graph_lib::estimate_triangles_wedge(graph<V,undirected> const & g, sampling_options const & options)
+    -> triangle_estimate
+{
+    static_assert(undirected == true, "graph has to be undirected");
+    assert(options.sample_size > 0 || options.relative_error > 0.0);
+
+    auto adjacency = detail::make_compact_adjacency(g);
+    auto const vertices = adjacency.num_vertices();
+
+    // wedges centered in the vertices [0, u) and the sorted lists for the closing test
+    std::vector<std::uint64_t> wedges_before(vertices + 1);
+    for (std::size_t u = 0; u < vertices; ++u)
+    {
+        auto const degree = std::uint64_t{adjacency.degree(u)};
+        wedges_before[u + 1] = wedges_before[u] + (degree < 2 ? 0 : degree * (degree - 1) / 2);
+    }
+    detail::parallel_for(vertices, [&](std::size_t begin, std::size_t end)
+    {
+        for (auto u = begin; u < end; ++u)
+        {
+            std::sort(std::begin(adjacency.targets) + static_cast<std::ptrdiff_t>(adjacency.offsets[u]),
+                      std::begin(adjacency.targets) + static_cast<std::ptrdiff_t>(adjacency.offsets[u + 1]));
+        }
+    }, 1024);
+
+    auto const wedges = wedges_before.back();
+    if (wedges == 0)
+    {
+        return triangle_estimate{0.0, 0.0, 0.0, 0};
+    }
+
+    auto const z = detail::normal_quantile(options.confidence);
+    std::mt19937_64 generator{options.seed};
+    std::uniform_int_distribution<std::uint64_t> pick_wedge{0, wedges - 1};
+
+    auto const sample = [&]
+    {
+        auto const wedge  = pick_wedge(generator);
+        auto const center = static_cast<std::size_t>(std::upper_bound(std::cbegin(wedges_before), std::cend(wedges_before), wedge)
+                                                     - std::cbegin(wedges_before) - 1);
+        auto const degree = adjacency.degree(center);
+
+        std::uniform_int_distribution<std::size_t> pick_neighbor{0, degree - 1};
+        auto const first = pick_neighbor(generator);
+        auto second = pick_neighbor(generator);
+        while (second == first)
+        {
+            second = pick_neighbor(generator);
+        }
+
+        auto const v = adjacency.targets[adjacency.offsets[center] + first];
+        auto const w = adjacency.targets[adjacency.offsets[center] + second];
+        auto const begin = std::cbegin(adjacency.targets);
+        return std::binary_search(begin + static_cast<std::ptrdiff_t>(adjacency.offsets[v]),
+                                  begin + static_cast<std::ptrdiff_t>(adjacency.offsets[v + 1]), w);
+    };
+
+    auto const target = options.sample_size > 0 ? options.sample_size : detail::max_samples;
+    std::size_t samples{}, closed{};
+    while (samples < target)
+    {
+        auto const batch = std::min(target - samples, detail::wedge_batch);
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            if (sample())
+            {
+                ++closed;
+            }
+        }
+        samples += batch;
+
+        if (options.sample_size == 0 && closed > 0 &&
+            detail::precise_enough(detail::wedge_estimate(closed, samples, static_cast<double>(wedges), z), options.relative_error))
+        {
+            break;
+        }
+    }
+
+    return detail::wedge_estimate(closed, samples, static_cast<double>(wedges), z);
+}
@@ -3,6 +3,8 @@
 
 #include "graph_lib_base.hpp"
 #include "graph_algorithms.hpp"
+#include "result_cache.hpp"
+#include "dual_graph.hpp"
 
 // included only in case some debug lines are needed
 #include <iostream>
@@ -79,6 +81,12 @@ TEST(algorithms, find_triangular_faces)
                                                                          std::tuple{ "C1","C3","C4"},
                                                                         };
     ASSERT_EQ(results, vec);
+
+    // streaming version visits the same triples in the same order
+    std::vector<std::tuple<std::string, std::string, std::string> > streamed{};
+    graph_lib::for_each_triangular_face(g, [&](auto const & u, auto const & v, auto const & w)
+                                           { streamed.emplace_back(u, v, w); });
+    ASSERT_EQ(streamed, vec);
 }
 
 /*
@@ -195,3 +203,273 @@ TEST(algorithms, find_orders_of_vertices)
   ASSERT_EQ(res, vec);
 
 }
+
+TEST(algorithms, find_connected_components)
+{
+  graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B','C'} },
+                                         std::pair{'B', std::vector{'A','C'} },
+                                         std::pair{'C', std::vector{'A','B'} },
+                                         std::pair{'D', std::vector{'E'} },
+                                         std::pair{'E', std::vector{'D'} },
+                                         std::pair{'F', std::vector<char>{} }
+                                       }
+                          };
+
+  auto const components = graph_lib::find_connected_components(g);
+
+  std::vector labels{ std::pair{'A', std::size_t{0}}, std::pair{'B', std::size_t{0}}, std::pair{'C', std::size_t{0}},
+                      std::pair{'D', std::size_t{1}}, std::pair{'E', std::size_t{1}}, std::pair{'F', std::size_t{2}} };
+  std::vector<std::size_t> sizes{3, 2, 1};
+
+  ASSERT_EQ(components.labels, labels);
+  ASSERT_EQ(components.sizes, sizes);
+  ASSERT_EQ(false, graph_lib::is_connected(g));
+
+  g.insert_edge('C', 'D');
+  g.insert_edge('F', 'A');
+
+  ASSERT_EQ(true, graph_lib::is_connected(g));
+  ASSERT_EQ(false, graph_lib::is_connected(graph_lib::graph<char>{}));
+}
+
+TEST(algorithms, find_connected_components_large)
+{
+  // a long path split into blocks, large enough to be processed by several threads
+  constexpr int block = 10000;
+  constexpr int blocks = 7;
+
+  graph_lib::graph<int>::graph_vector_type adjacency{};
+  for (int i = 0; i < block * blocks; ++i)
+  {
+    std::vector<int> neighbors{};
+    if (i % block != 0)
+    {
+      neighbors.emplace_back(i - 1);
+    }
+    if ((i + 1) % block != 0)
+    {
+      neighbors.emplace_back(i + 1);
+    }
+    adjacency.emplace_back(std::pair{i, std::move(neighbors)});
+  }
+
+  graph_lib::graph<int> g{std::move(adjacency)};
+  auto const components = graph_lib::find_connected_components(g);
+
+  ASSERT_EQ(components.sizes, std::vector<std::size_t>(blocks, block));
+  for (auto const & [vertex, label] : components.labels)
+  {
+    ASSERT_EQ(static_cast<std::size_t>(vertex / block), label);
+  }
+}
+
+TEST(algorithms, execution_policies)
+{
+  // path with a star at every tenth vertex, large enough to be split into several chunks
+  constexpr int vertices = 20000;
+
+  graph_lib::graph<int>::graph_vector_type adjacency{};
+  for (int i = 0; i < vertices; ++i)
+  {
+    std::vector<int> neighbors{};
+    if (i > 0)
+    {
+      neighbors.emplace_back(i - 1);
+    }
+    if (i + 1 < vertices)
+    {
+      neighbors.emplace_back(i + 1);
+    }
+    if (i % 10 == 0)
+    {
+      neighbors.emplace_back(vertices + i);
+    }
+    adjacency.emplace_back(std::pair{i, std::move(neighbors)});
+  }
+  for (int i = 0; i < vertices; i += 10)
+  {
+    adjacency.emplace_back(std::pair{vertices + i, std::vector<int>{i}});
+  }
+  graph_lib::graph<int> g{std::move(adjacency)};
+
+  using graph_lib::execution::seq;
+  using graph_lib::execution::par;
+  using graph_lib::execution::par_unseq;
+
+  auto const same_degree = graph_lib::find_all_connected_vertices_of_the_same_degree(g, 2);
+  ASSERT_EQ(same_degree, graph_lib::find_all_connected_vertices_of_the_same_degree(seq, g, 2));
+  ASSERT_EQ(same_degree, graph_lib::find_all_connected_vertices_of_the_same_degree(par, g, 2));
+  ASSERT_EQ(same_degree, graph_lib::find_all_connected_vertices_of_the_same_degree(par_unseq, g, 2));
+
+  // parallel sort is stable, so it matches the stable sort of the serial degrees
+  auto orders = graph_lib::find_orders_of_vertices(g);
+  std::stable_sort(std::begin(orders), std::end(orders), [](auto const & first, auto const & second)
+                                                          { return first.first < second.first; });
+  std::stable_sort(std::begin(orders), std::end(orders), [](auto const & first, auto const & second)
+                                                          { return first.second < second.second; });
+  ASSERT_EQ(orders, graph_lib::find_orders_of_vertices(par, g));
+
+  std::vector<std::tuple<int,int,int>> triangles{};
+  for (int i = 0; i < vertices; ++i)
+  {
+    triangles.emplace_back(std::tuple{i % 7, i, i + 1});
+  }
+  auto const cone = graph_lib::cone_triangulation(triangles, 3);
+  ASSERT_EQ(cone, graph_lib::cone_triangulation(par, triangles, 3));
+  ASSERT_EQ(cone, graph_lib::cone_triangulation(seq, triangles, 3));
+}
+
+TEST(algorithms, result_cache)
+{
+  graph_lib::graph<int> g{std::vector { std::pair{1, std::vector{2, 3} },
+                                        std::pair{2, std::vector{1, 3} },
+                                        std::pair{3, std::vector{1, 2} }
+                                      }
+                         };
+
+  graph_lib::result_cache cache{1 << 20};
+
+  auto const faces = cache.find_triangular_faces(g);
+  ASSERT_EQ(graph_lib::find_triangular_faces(g), *faces);
+  ASSERT_EQ(faces, cache.find_triangular_faces(g));
+  ASSERT_EQ(1, cache.statistics().hits);
+  ASSERT_EQ(1, cache.statistics().misses);
+
+  // different parameters are different results
+  ASSERT_EQ(6, cache.find_all_connected_vertices_of_the_same_degree(g, 2)->size());
+  ASSERT_EQ(0, cache.find_all_connected_vertices_of_the_same_degree(g, 1)->size());
+  ASSERT_EQ(3, cache.statistics().entries);
+
+  // modified graph misses and replaces the stale result, the old result stays valid
+  g.insert_vertex(4);
+  g.insert_edge(3, 4);
+  auto const modified = cache.find_triangular_faces(g);
+  ASSERT_NE(faces, modified);
+  ASSERT_EQ(graph_lib::find_triangular_faces(g), *modified);
+  ASSERT_EQ(3, cache.statistics().entries);
+  ASSERT_EQ(4, cache.statistics().misses);
+
+  // the copy has its own results
+  auto const copy = g.snapshot();
+  ASSERT_NE(modified, cache.find_triangular_faces(copy));
+  ASSERT_EQ(5, cache.statistics().misses);
+
+  auto computations = 0;
+  auto const compute = [&]{ ++computations; return std::vector<int>(1000); };
+  ASSERT_EQ(1000, cache.get(g, "custom", {}, compute)->size());
+  ASSERT_EQ(1000, cache.get(g, "custom", {}, compute)->size());
+  ASSERT_EQ(1, computations);
+
+  cache.clear();
+  ASSERT_EQ(0, cache.statistics().entries);
+  ASSERT_EQ(0, cache.statistics().memory_used);
+  cache.get(g, "custom", {}, compute);
+  ASSERT_EQ(2, computations);
+
+  // the moved graph keeps its results, the emptied moved-from graph doesn't see them
+  auto const id = g.id();
+  graph_lib::graph<int> moved{std::move(g)};
+  ASSERT_EQ(id, moved.id());
+  ASSERT_NE(id, g.id());
+  ASSERT_EQ(1000, cache.get(moved, "custom", {}, compute)->size());
+  ASSERT_EQ(2, computations);
+  ASSERT_EQ(1000, cache.get(g, "custom", {}, compute)->size());
+  ASSERT_EQ(3, computations);
+
+  graph_lib::graph<int> assigned{};
+  assigned = std::move(moved);
+  ASSERT_EQ(id, assigned.id());
+  ASSERT_NE(id, moved.id());
+  ASSERT_EQ(0, cache.find_triangular_faces(moved)->size());
+}
+
+TEST(algorithms, result_cache_eviction)
+{
+  graph_lib::graph<int> g{};
+  auto const result = [](std::size_t size){ return [size]{ return std::vector<char>(size); }; };
+
+  // room for two of the results
+  graph_lib::result_cache cache{2 * (sizeof(std::vector<char>) + 1000)};
+
+  cache.get(g, "first", {}, result(1000));
+  cache.get(g, "second", {}, result(1000));
+  cache.get(g, "first", {}, result(1000));
+  cache.get(g, "third", {}, result(1000));
+  ASSERT_EQ(1, cache.statistics().evictions);
+  ASSERT_EQ(2, cache.statistics().entries);
+  ASSERT_GE(2 * (sizeof(std::vector<char>) + 1000), cache.statistics().memory_used);
+
+  // second was the least recently used one
+  auto const misses = cache.statistics().misses;
+  cache.get(g, "first", {}, result(1000));
+  cache.get(g, "third", {}, result(1000));
+  ASSERT_EQ(misses, cache.statistics().misses);
+  cache.get(g, "second", {}, result(1000));
+  ASSERT_EQ(misses + 1, cache.statistics().misses);
+
+  // too large result is returned but not cached
+  auto const large = cache.get(g, "large", {}, result(1 << 20));
+  ASSERT_EQ(1 << 20, large->size());
+  ASSERT_EQ(2, cache.statistics().entries);
+  cache.get(g, "large", {}, result(1 << 20));
+  ASSERT_EQ(misses + 3, cache.statistics().misses);
+}
+
+TEST(algorithms, dual_graph)
+{
+  // faces of the octahedron, the dual is the cube
+  std::vector<std::tuple<char,char,char>> triangles{ {'A','B','C'}, {'A','C','D'}, {'A','D','E'}, {'A','E','B'},
+                                                     {'F','C','B'}, {'F','D','C'}, {'F','E','D'}, {'F','B','E'} };
+  auto const cube = graph_lib::dual_graph(triangles);
+  ASSERT_EQ(8, cube.num_vertices());
+  ASSERT_EQ(12, cube.num_edges());
+  ASSERT_EQ((std::vector<std::size_t>{1, 3, 4}), cube.adjacent_vertices(0));
+  for (std::size_t face = 0; face < 8; ++face)
+  {
+    ASSERT_EQ(3, cube.degree(face));
+  }
+
+  // faces of the cube as the polygons, the dual is the octahedron
+  std::vector<std::vector<int>> squares{ {0,1,2,3}, {4,5,6,7}, {0,1,5,4}, {1,2,6,5}, {2,3,7,6}, {3,0,4,7} };
+  auto const octahedron = graph_lib::dual_graph(squares);
+  ASSERT_EQ(6, octahedron.num_vertices());
+  ASSERT_EQ(12, octahedron.num_edges());
+  ASSERT_EQ(false, octahedron.are_adjacent(0, 1));
+  ASSERT_EQ(true, octahedron.are_adjacent(0, 2));
+
+  // triangulated grid, the faces are adjacent trough the inner edges
+  constexpr int side = 40;
+  std::vector<std::tuple<int,int,int>> grid{};
+  graph_lib::graph<int> g{};
+  for (int v = 0; v < side * side; ++v)
+  {
+    g.insert_vertex(int{v});
+  }
+  for (int row = 0; row + 1 < side; ++row)
+  {
+    for (int column = 0; column + 1 < side; ++column)
+    {
+      auto const v = row * side + column;
+      grid.emplace_back(v, v + 1, v + side + 1);
+      grid.emplace_back(v, v + side, v + side + 1);
+    }
+  }
+
+  auto const dual = graph_lib::dual_graph(grid);
+  ASSERT_EQ(grid.size(), dual.num_vertices());
+  ASSERT_EQ(2 * side * (side - 1) + (side - 1) * (side - 1) - 4 * (side - 1), dual.num_edges());
+
+  auto const same = [&](graph_lib::graph<std::size_t> const & other)
+  {
+    for (std::size_t face = 0; face < grid.size(); ++face)
+    {
+      if (dual.adjacent_vertices(face) != other.adjacent_vertices(face))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  ASSERT_EQ(true, same(graph_lib::dual_graph(graph_lib::execution::par, grid)));
+  ASSERT_EQ(true, same(graph_lib::dual_graph(g, grid)));
+}
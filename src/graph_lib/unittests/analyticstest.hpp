@@ -0,0 +1,333 @@
+#include <gtest/gtest.h>
+
+#include "triangle_counting.hpp"
+#include "compressed_graph.hpp"
+#include "graph_algorithms.hpp"
+#include "subgraph_view.hpp"
+#include "distances.hpp"
+#include "testgraphs.hpp"
+#include <queue>
+
+TEST(analytics, count_triangles)
+{
+    // octahedron, 8 faces and no other triangles
+    graph_lib::graph<char> octahedron{std::vector { std::pair{'A', std::vector{'B','C','D','E'} },
+                                                    std::pair{'B', std::vector{'A','C','E','F'} },
+                                                    std::pair{'C', std::vector{'A','B','D','F'} },
+                                                    std::pair{'D', std::vector{'A','C','E','F'} },
+                                                    std::pair{'E', std::vector{'A','B','D','F'} },
+                                                    std::pair{'F', std::vector{'B','C','D','E'} }
+                                                  }
+                                     };
+    ASSERT_EQ(8, graph_lib::count_triangles(octahedron));
+    ASSERT_EQ(8, graph_lib::count_triangles(graph_lib::compressed_graph<char>{octahedron}));
+
+    // every square of the grid holds two triangles
+    auto const g = make_triangulated_grid(50);
+    graph_lib::compressed_graph<int> const c{g};
+    ASSERT_EQ(2 * 49 * 49, graph_lib::count_triangles(g));
+    ASSERT_EQ(graph_lib::find_triangles(c).size(), graph_lib::count_triangles(c));
+
+    graph_lib::graph<int> empty{};
+    ASSERT_EQ(0, graph_lib::count_triangles(empty));
+}
+
+TEST(analytics, estimate_triangles)
+{
+    auto const g = make_triangulated_grid(200);
+    auto const exact = static_cast<double>(graph_lib::count_triangles(g));
+
+    // with the target relative error
+    graph_lib::sampling_options options{};
+    options.relative_error = 0.05;
+
+    for (auto const & estimate : {graph_lib::estimate_triangles_doulion(g, options),
+                                  graph_lib::estimate_triangles_wedge(g, options)})
+    {
+        ASSERT_GT(estimate.samples, 0);
+        ASSERT_LE(estimate.lower, estimate.estimate);
+        ASSERT_GE(estimate.upper, estimate.estimate);
+        ASSERT_LE((estimate.upper - estimate.lower) / 2, 0.05 * estimate.estimate);
+        // the interval misses the exact count with 5% probability, twice its width is the safe margin
+        ASSERT_NEAR(exact, estimate.estimate, estimate.upper - estimate.lower);
+    }
+
+    // with the given sample size, the same seed gives the same estimate
+    options.sample_size = 20000;
+    auto const wedge = graph_lib::estimate_triangles_wedge(g, options);
+    ASSERT_EQ(20000, wedge.samples);
+    ASSERT_EQ(wedge.estimate, graph_lib::estimate_triangles_wedge(g, options).estimate);
+    ASSERT_NEAR(exact, wedge.estimate, 0.1 * exact);
+
+    // sample larger than the graph keeps every edge, the count is exact
+    options.sample_size = 100 * g.num_edges();
+    auto const doulion = graph_lib::estimate_triangles_doulion(g, options);
+    ASSERT_EQ(exact, doulion.estimate);
+    ASSERT_EQ(exact, doulion.lower);
+    ASSERT_EQ(exact, doulion.upper);
+}
+
+TEST(analytics, find_core_decomposition)
+{
+    // K4 (A, B, C, D) with the triangle (D, E, F) hanging on D and the pendant vertex G
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B','C','D'} },
+                                           std::pair{'B', std::vector{'A','C','D'} },
+                                           std::pair{'C', std::vector{'A','B','D'} },
+                                           std::pair{'D', std::vector{'A','B','C','E','F'} },
+                                           std::pair{'E', std::vector{'D','F'} },
+                                           std::pair{'F', std::vector{'D','E','G'} },
+                                           std::pair{'G', std::vector{'F'} },
+                                           std::pair{'H', std::vector<char>{} }
+                                         }
+                            };
+
+    auto const cores = graph_lib::find_core_decomposition(g);
+
+    std::vector core_numbers{ std::pair{'A', std::size_t{3}}, std::pair{'B', std::size_t{3}}, std::pair{'C', std::size_t{3}},
+                              std::pair{'D', std::size_t{3}}, std::pair{'E', std::size_t{2}}, std::pair{'F', std::size_t{2}},
+                              std::pair{'G', std::size_t{1}}, std::pair{'H', std::size_t{0}} };
+    ASSERT_EQ(core_numbers, cores.core_numbers);
+    ASSERT_EQ(3, cores.degeneracy);
+
+    // every vertex has at most degeneracy neighbors later in the ordering
+    auto const check_ordering = [](auto const & graph, auto const & decomposition)
+    {
+        ASSERT_EQ(graph.num_vertices(), decomposition.ordering.size());
+        std::unordered_map<typename std::decay_t<decltype(graph)>::node_type, std::size_t> position{};
+        for (std::size_t i = 0; i < decomposition.ordering.size(); ++i)
+        {
+            position[decomposition.ordering[i]] = i;
+        }
+        ASSERT_EQ(graph.num_vertices(), position.size());
+        for (auto it = graph.cbegin(); it != graph.cend(); ++it)
+        {
+            auto const & [vertex, edges] = *it;
+            auto const later = std::count_if(std::cbegin(edges), std::cend(edges),
+                                             [&](auto const & u){ return position[u] > position[vertex]; });
+            ASSERT_LE(static_cast<std::size_t>(later), decomposition.degeneracy);
+        }
+    };
+    check_ordering(g, cores);
+
+    // triangulated grid is 3-degenerate, the two corners that the diagonals miss have degree 2
+    auto const grid = make_triangulated_grid(40);
+    auto const grid_cores = graph_lib::find_core_decomposition(grid);
+    ASSERT_EQ(3, grid_cores.degeneracy);
+    ASSERT_EQ(3, grid_cores.core_numbers[0].second);
+    ASSERT_EQ(2, grid_cores.core_numbers[39].second);
+    check_ordering(grid, grid_cores);
+
+    ASSERT_EQ(0, graph_lib::find_core_decomposition(graph_lib::graph<int>{}).degeneracy);
+}
+
+TEST(analytics, induced_subgraph)
+{
+    auto const g = make_triangulated_grid(20);
+
+    // the view refers to the graph, so it can't be made for the temporary
+    auto const keep_all = [](int){ return true; };
+    static_assert(!std::is_constructible_v<graph_lib::induced_subgraph<int>, graph_lib::graph<int> &&, decltype(keep_all)>);
+    static_assert(!std::is_constructible_v<graph_lib::induced_subgraph<int>, graph_lib::graph<int> &&, std::vector<char>>);
+    static_assert(std::is_constructible_v<graph_lib::induced_subgraph<int>, graph_lib::graph<int> const &, decltype(keep_all)>);
+
+    // the view of all of the vertices gives the same results as the graph itself
+    graph_lib::induced_subgraph const all{g, [](int){ return true; }};
+    ASSERT_EQ(g.num_vertices(), all.num_vertices());
+    ASSERT_EQ(g.num_edges(), all.num_edges());
+    ASSERT_EQ(graph_lib::find_triangular_faces(g), graph_lib::find_triangular_faces(all));
+    ASSERT_EQ(graph_lib::count_triangles(g), graph_lib::count_triangles(all));
+    ASSERT_EQ(graph_lib::find_orders_of_vertices(g), graph_lib::find_orders_of_vertices(all));
+    ASSERT_EQ(graph_lib::find_all_connected_vertices_of_the_same_degree(g, 6),
+              graph_lib::find_all_connected_vertices_of_the_same_degree(all, 6));
+
+    // any other view gives the same results as the graph built from it
+    auto const keep = [](int vertex){ return vertex % 3 != 0; };
+    graph_lib::induced_subgraph const view{g, keep};
+
+    graph_lib::graph<int>::graph_vector_type adjacency{};
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        if (keep(it->first))
+        {
+            std::vector<int> neighbors{};
+            std::copy_if(std::cbegin(it->second), std::cend(it->second), std::back_inserter(neighbors), keep);
+            adjacency.emplace_back(it->first, std::move(neighbors));
+        }
+    }
+    graph_lib::graph<int> const built{std::move(adjacency)};
+
+    ASSERT_EQ(built.num_vertices(), view.num_vertices());
+    ASSERT_EQ(built.num_edges(), view.num_edges());
+    ASSERT_EQ(graph_lib::find_triangular_faces(built), graph_lib::find_triangular_faces(view));
+    ASSERT_EQ(graph_lib::count_triangles(built), graph_lib::count_triangles(view));
+    ASSERT_EQ(graph_lib::find_orders_of_vertices(built), graph_lib::find_orders_of_vertices(view));
+    ASSERT_EQ(graph_lib::find_all_connected_vertices_of_the_same_degree(built, 4),
+              graph_lib::find_all_connected_vertices_of_the_same_degree(view, 4));
+    ASSERT_EQ(graph_lib::find_connected_components(built).labels, graph_lib::find_connected_components(view).labels);
+    ASSERT_EQ(graph_lib::find_core_decomposition(built).core_numbers, graph_lib::find_core_decomposition(view).core_numbers);
+
+    ASSERT_EQ(false, view.contains(3));
+    ASSERT_EQ(built.degree(22), view.degree(22));
+    ASSERT_EQ(false, view.are_adjacent(2, 3));
+    auto const vertices = view.vertices();
+    ASSERT_EQ(true, std::equal(std::begin(vertices), std::end(vertices), built.vertices().begin()));
+
+    // mask of the two opposite corners, the view has no edges
+    std::vector<char> mask(g.num_vertices());
+    mask.front() = 1;
+    mask.back()  = 1;
+    graph_lib::induced_subgraph const corners{g, std::move(mask)};
+    ASSERT_EQ(2, corners.num_vertices());
+    ASSERT_EQ(0, corners.num_edges());
+    ASSERT_EQ(2, graph_lib::find_connected_components(corners).sizes.size());
+}
+
+namespace
+{
+    // distances from the source by the plain BFS, -1 for the vertices that can't be reached
+    template <typename G>
+    auto bfs_distances(G const & g, int source)
+        -> std::vector<int>
+    {
+        auto const & index = g.vertex_index();
+        std::vector<int> distance(g.num_vertices(), -1);
+        std::queue<int> queue{};
+        distance[index.at(source)] = 0;
+        queue.push(source);
+        while (!queue.empty())
+        {
+            auto const v = queue.front();
+            queue.pop();
+            for (auto const u : g.adjacent_vertices(v))
+            {
+                if (distance[index.at(u)] < 0)
+                {
+                    distance[index.at(u)] = distance[index.at(v)] + 1;
+                    queue.push(u);
+                }
+            }
+        }
+        return distance;
+    }
+}
+
+TEST(analytics, find_distances)
+{
+    // 400 vertices, so the sources take two of the wide batches
+    auto g = make_triangulated_grid(20);
+    g.insert_vertex(-1);
+
+    auto const all = graph_lib::find_all_distances(g);
+    ASSERT_EQ(true, all.has_value());
+    ASSERT_EQ(g.num_vertices(), all->sources.size());
+    for (std::size_t i = 0; i < all->sources.size(); i += 7)
+    {
+        auto const expected = bfs_distances(g, all->sources[i]);
+        for (std::size_t j = 0; j < all->targets.size(); ++j)
+        {
+            auto const d = all->distance(i, j);
+            ASSERT_EQ(expected[j], d == all->unreachable ? -1 : int{d});
+        }
+    }
+
+    // a few sources take one narrow batch, the same source can be given twice
+    std::vector<int> sources{0, 399, 210, 0};
+    auto const some = graph_lib::find_distances<std::uint8_t>(g, sources);
+    ASSERT_EQ(true, some.has_value());
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        auto const row = std::find(std::cbegin(all->sources), std::cend(all->sources), sources[i]) - std::cbegin(all->sources);
+        for (std::size_t j = 0; j < some->targets.size(); ++j)
+        {
+            auto const d = some->distance(i, j);
+            ASSERT_EQ(all->distance(static_cast<std::size_t>(row), j), d == some->unreachable ? all->unreachable : d);
+        }
+    }
+
+    // path of 300 vertices, the distances don't fit into 8 bits
+    graph_lib::graph<int> path{};
+    for (int i = 0; i < 300; ++i)
+    {
+        path.insert_vertex(int{i});
+        if (i > 0)
+        {
+            path.insert_edge(i - 1, i);
+        }
+    }
+    ASSERT_EQ(false, graph_lib::find_distances<std::uint8_t>(path, std::vector{0}).has_value());
+    ASSERT_EQ(299, graph_lib::find_distances(path, std::vector{0})->distance(0, 299));
+
+    // directed distances go along the edges
+    graph_lib::graph<int, false> directed{std::vector { std::pair{1, std::vector{2} },
+                                                        std::pair{2, std::vector{3} },
+                                                        std::pair{3, std::vector<int>{} }
+                                                      }
+                                         };
+    auto const arcs = graph_lib::find_all_distances(directed);
+    ASSERT_EQ(2, arcs->distance(0, 2));
+    ASSERT_EQ(arcs->unreachable, arcs->distance(2, 0));
+}
+
+TEST(analytics, find_vertex_coloring)
+{
+    auto const g = make_triangulated_grid(60);
+
+    auto const proper = [&](auto const & coloring)
+    {
+        auto const & index = g.vertex_index();
+        for (auto const e : g.edges())
+        {
+            if (coloring.colors[index.at(e.source())].second == coloring.colors[index.at(e.target())].second)
+            {
+                return false;
+            }
+        }
+        std::size_t colored{};
+        for (std::size_t color = 0; color < coloring.classes.size(); ++color)
+        {
+            colored += coloring.classes[color].size();
+            for (auto const v : coloring.classes[color])
+            {
+                if (coloring.colors[index.at(v)].second != color)
+                {
+                    return false;
+                }
+            }
+        }
+        return colored == g.num_vertices();
+    };
+
+    // the grid is 3-degenerate, so the smallest last ordering needs at most 4 colors
+    auto const coloring = graph_lib::find_vertex_coloring(g);
+    ASSERT_EQ(true, proper(coloring));
+    ASSERT_GE(4, coloring.classes.size());
+    ASSERT_LE(3, coloring.classes.size());
+    ASSERT_EQ(coloring.colors, graph_lib::find_vertex_coloring(g).colors);
+
+    for (auto const order : {graph_lib::coloring_order::largest_first, graph_lib::coloring_order::random})
+    {
+        auto const other = graph_lib::find_vertex_coloring(g, order);
+        ASSERT_EQ(true, proper(other));
+        ASSERT_GE(7, other.classes.size());
+    }
+
+    // two opposite vertices of the octahedron are independent
+    graph_lib::graph<char> octahedron{std::vector { std::pair{'A', std::vector{'B','C','D','E'} },
+                                                    std::pair{'B', std::vector{'A','C','E','F'} },
+                                                    std::pair{'C', std::vector{'A','B','D','F'} },
+                                                    std::pair{'D', std::vector{'A','C','E','F'} },
+                                                    std::pair{'E', std::vector{'A','B','D','F'} },
+                                                    std::pair{'F', std::vector{'B','C','D','E'} }
+                                                  }
+                                     };
+    auto const three = graph_lib::find_vertex_coloring(octahedron);
+    ASSERT_EQ(3, three.classes.size());
+    for (auto const & color_class : three.classes)
+    {
+        ASSERT_EQ(2, color_class.size());
+    }
+
+    graph_lib::induced_subgraph const view{g, [](int vertex){ return vertex % 2 == 0; }};
+    auto const view_coloring = graph_lib::find_vertex_coloring(view);
+    ASSERT_EQ(view.num_vertices(), view_coloring.colors.size());
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "compressed_graph.hpp"
+
+TEST(compressed_graph, construct)
+{
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'C','B','D'} },
+                                           std::pair{'B', std::vector{'A','C'} },
+                                           std::pair{'C', std::vector{'B','A'} },
+                                           std::pair{'D', std::vector{'A'} }
+                                         }
+                            };
+
+    graph_lib::compressed_graph<char> c{g};
+
+    ASSERT_EQ(4, c.num_vertices());
+    ASSERT_EQ(4, c.num_edges());
+    ASSERT_EQ(3, c.degree('A'));
+    ASSERT_EQ(1, c.degree('D'));
+
+    // neighbors are ordered by their ids, which is the order of the vertices in g
+    auto const neighbors = c.adjacent_vertices('A');
+    ASSERT_EQ((std::vector<char>{'B','C','D'}), (std::vector<char>(neighbors.begin(), neighbors.end())));
+
+    ASSERT_EQ(true, c.are_adjacent('A', 'B'));
+    ASSERT_EQ(true, c.are_adjacent('D', 'A'));
+    ASSERT_EQ(false, c.are_adjacent('B', 'D'));
+
+    ASSERT_DEATH((void)c.degree('G'), "Assertion `it != std::cend\\(_ids_by_vertex\\) && _vertices\\[\\*it\\] == key' failed\\.");
+}
+
+TEST(compressed_graph, large_gaps)
+{
+    // neighbors far apart need multi-byte varints
+    graph_lib::graph<int>::graph_vector_type adjacency{};
+    constexpr int vertices = 100000;
+    for (int i = 0; i < vertices; ++i)
+    {
+        adjacency.emplace_back(std::pair{i, std::vector<int>{(i + 1) % vertices, (i + vertices - 1) % vertices,
+                                                             (i + vertices / 2) % vertices}});
+    }
+
+    graph_lib::graph<int> g{std::move(adjacency)};
+    graph_lib::compressed_graph<int> c{g};
+
+    ASSERT_EQ(g.num_edges(), c.num_edges());
+    for (int i = 0; i < vertices; i += 997)
+    {
+        auto expected = g.adjacent_vertices(i);
+        std::sort(std::begin(expected), std::end(expected));
+        auto const neighbors = c.adjacent_vertices(i);
+
+        ASSERT_EQ(expected, (std::vector<int>(neighbors.begin(), neighbors.end())));
+        ASSERT_EQ(true, c.are_adjacent(i, (i + vertices / 2) % vertices));
+        ASSERT_EQ(false, c.are_adjacent(i, (i + 2) % vertices));
+    }
+}
+
+TEST(compressed_graph, find_triangles)
+{
+    graph_lib::graph<std::string> g{ std::vector
+                                                { std::pair{std::string{"A1"}, std::vector<std::string>{"A2","A5","B1","C1","C4"} },
+                                                  std::pair{std::string{"A2"}, std::vector<std::string>{"A1","A3","B1","B2","C3","C4"} },
+                                                  std::pair{std::string{"A3"}, std::vector<std::string>{"A2","A4","B2","B3","C2","C3"} },
+                                                  std::pair{std::string{"A4"}, std::vector<std::string>{"A3","A5","B3","B4","C1","C2"} },
+                                                  std::pair{std::string{"A5"}, std::vector<std::string>{"A1","A4","B1","B4","C1"} },
+                                                  std::pair{std::string{"B1"}, std::vector<std::string>{"A1","A2","A5","B2","B4","B5"} },
+                                                  std::pair{std::string{"B2"}, std::vector<std::string>{"A2","A3","B1","B3","B5"} },
+                                                  std::pair{std::string{"B3"}, std::vector<std::string>{"A3","A4","B2","B4","B5"} },
+                                                  std::pair{std::string{"B4"}, std::vector<std::string>{"A4","A5","B1","B3","B5"} },
+                                                  std::pair{std::string{"B5"}, std::vector<std::string>{"B1","B2","B3","B4"} },
+                                                  std::pair{std::string{"C1"}, std::vector<std::string>{"A1","A4","A5","C2","C3","C4"} },
+                                                  std::pair{std::string{"C2"}, std::vector<std::string>{"A3","A4","C1","C3"} },
+                                                  std::pair{std::string{"C3"}, std::vector<std::string>{"A2","A3","C1","C2","C4"} },
+                                                  std::pair{std::string{"C4"}, std::vector<std::string>{"A1","A2","C1","C3"} }
+                                                }
+                                   };
+
+    graph_lib::compressed_graph<std::string> c{g};
+    auto const results = graph_lib::find_triangles(c);
+
+    std::vector<std::tuple<std::string, std::string, std::string> > vec{ std::tuple{ "A1","A2","B1"}, std::tuple{ "A1","A2","C4"}, std::tuple{ "A1","A5","B1"},
+                                                                         std::tuple{ "A1","A5","C1"}, std::tuple{ "A1","C1","C4"}, std::tuple{ "A2","A3","B2"},
+                                                                         std::tuple{ "A2","A3","C3"}, std::tuple{ "A2","B1","B2"}, std::tuple{ "A2","C3","C4"},
+                                                                         std::tuple{ "A3","A4","B3"}, std::tuple{ "A3","A4","C2"}, std::tuple{ "A3","B2","B3"},
+                                                                         std::tuple{ "A3","C2","C3"}, std::tuple{ "A4","A5","B4"}, std::tuple{ "A4","A5","C1"},
+                                                                         std::tuple{ "A4","B3","B4"}, std::tuple{ "A4","C1","C2"}, std::tuple{ "A5","B1","B4"},
+                                                                         std::tuple{ "B1","B2","B5"}, std::tuple{ "B1","B4","B5"}, std::tuple{ "B2","B3","B5"},
+                                                                         std::tuple{ "B3","B4","B5"}, std::tuple{ "C1","C2","C3"}, std::tuple{ "C1","C3","C4"},
+                                                                        };
+    ASSERT_EQ(results, vec);
+}
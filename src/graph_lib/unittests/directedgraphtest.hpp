@@ -185,4 +185,28 @@ TEST(directed_graph, are_adjacent)
     ASSERT_EQ(true, g.are_adjacent('E','G'));
     ASSERT_EQ(false, g.are_adjacent('G','E'));
 
-}
\ No newline at end of file
+}
+TEST(directed_graph, views)
+{
+    graph_lib::graph<char, false> g{std::vector { std::pair{'A', std::vector{'B'} },
+                                                  std::pair{'B', std::vector{'A','C'} },
+                                                  std::pair{'C', std::vector<char>{} }
+                                                }
+                                   };
+
+    // every arc once, the arcs of the opposite directions are different edges
+    auto const edges = g.edges();
+    ASSERT_EQ(3, std::distance(std::begin(edges), std::end(edges)));
+    auto const is = [](char source, char target)
+    {
+        return [=](auto const e){ return e == graph_lib::edge<char, false>{source, target}; };
+    };
+    ASSERT_EQ(1, std::count_if(std::begin(edges), std::end(edges), is('A', 'B')));
+    ASSERT_EQ(1, std::count_if(std::begin(edges), std::end(edges), is('B', 'A')));
+    ASSERT_EQ(1, std::count_if(std::begin(edges), std::end(edges), is('B', 'C')));
+    ASSERT_EQ(0, std::count_if(std::begin(edges), std::end(edges), is('C', 'B')));
+
+    auto const incident = g.incident_edges('B');
+    ASSERT_NE(*std::begin(incident), (graph_lib::edge<char, false>{'B', 'C'}));
+    ASSERT_EQ(*std::begin(incident), (graph_lib::edge<char, false>{'B', 'A'}));
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "compressed_graph.hpp"
+#include "external_triangles.hpp"
+#include <array>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+TEST(external_triangles, find_triangles_external)
+{
+    // triangulated grid, every inner square is split by the diagonal and the corners are connected to the hub
+    constexpr int side = 40;
+    constexpr int hub  = side * side;
+    std::vector<std::pair<int, int>> edges{};
+    for (int row = 0; row < side; ++row)
+    {
+        for (int column = 0; column < side; ++column)
+        {
+            auto const v = row * side + column;
+            if (column + 1 < side) edges.emplace_back(v, v + 1);
+            if (row + 1 < side) edges.emplace_back(v, v + side);
+            if (column + 1 < side && row + 1 < side) edges.emplace_back(v, v + side + 1);
+            if ((row == 0 || row == side - 1) && (column == 0 || column == side - 1)) edges.emplace_back(hub, v);
+        }
+    }
+
+    graph_lib::graph<int>::graph_vector_type adjacency{};
+    for (int v = 0; v <= hub; ++v)
+    {
+        adjacency.emplace_back(v, std::vector<int>{});
+    }
+    for (auto const & [u, v] : edges)
+    {
+        adjacency[static_cast<std::size_t>(u)].second.emplace_back(v);
+        adjacency[static_cast<std::size_t>(v)].second.emplace_back(u);
+    }
+    auto expected = graph_lib::find_triangles(graph_lib::compressed_graph<int>{graph_lib::graph<int>{std::move(adjacency)}});
+
+    auto const sorted = [](auto triangles)
+    {
+        for (auto & [u, v, w] : triangles)
+        {
+            std::array<int, 3> corners{u, v, w};
+            std::sort(std::begin(corners), std::end(corners));
+            std::tie(u, v, w) = std::tuple{corners[0], corners[1], corners[2]};
+        }
+        std::sort(std::begin(triangles), std::end(triangles));
+        return triangles;
+    };
+
+    auto const source = [&](auto && visitor)
+    {
+        for (auto const & [u, v] : edges)
+        {
+            visitor(u, v);
+        }
+    };
+
+    // tiny budget forces many partitions, the default one keeps everything in one
+    for (std::size_t budget : {std::size_t{64}, std::size_t{512}, std::size_t{4096}, std::size_t{256} << 20})
+    {
+        std::vector<std::tuple<int,int,int>> found{};
+        graph_lib::external_memory_options options{};
+        options.memory_budget = budget;
+
+        ASSERT_EQ(true, graph_lib::find_triangles_external<int>(source, [&](int u, int v, int w)
+                                                                { found.emplace_back(u, v, w); }, options));
+        ASSERT_EQ(sorted(expected), sorted(found));
+    }
+}
+
+TEST(external_triangles, failing_sources)
+{
+    auto const path = std::filesystem::temp_directory_path() / "graph_lib_external_triangles_test.txt";
+    auto const count = [](auto source)
+    {
+        std::size_t triangles{};
+        auto const found = graph_lib::find_triangles_external<int>(source, [&](int, int, int){ ++triangles; });
+        return std::pair{found, triangles};
+    };
+
+    {
+        std::ofstream output{path};
+        output << "# two triangles sharing an edge\n1 2\n2 3\n3 1\n\n3 4\n4 2\n";
+    }
+    ASSERT_EQ((std::pair{true, std::size_t{2}}), count(graph_lib::edge_list_source<int>(path.string())));
+
+    // malformed line fails the whole search, just like read_edge_list
+    {
+        std::ofstream output{path};
+        output << "1 2\n2 3\n3 1\n3 x\n";
+    }
+    ASSERT_EQ((std::pair{false, std::size_t{0}}), count(graph_lib::edge_list_source<int>(path.string())));
+    {
+        std::ofstream output{path};
+        output << "1 2\n2 3 4\n3 1\n";
+    }
+    ASSERT_EQ((std::pair{false, std::size_t{0}}), count(graph_lib::edge_list_source<int>(path.string())));
+
+    std::filesystem::remove(path);
+    ASSERT_EQ((std::pair{false, std::size_t{0}}), count(graph_lib::edge_list_source<int>(path.string())));
+
+    // the source that fails in the later pass, or produces different edges, fails as well
+    auto calls = 0;
+    ASSERT_EQ(false, count([&](auto && visitor)
+    {
+        visitor(1, 2);
+        visitor(2, 3);
+        visitor(3, 1);
+        return ++calls < 2;
+    }).first);
+    calls = 0;
+    ASSERT_EQ(false, count([&](auto && visitor)
+    {
+        visitor(1, 2);
+        visitor(2, 3);
+        visitor(3, ++calls < 3 ? 1 : 4);
+    }).first);
+}
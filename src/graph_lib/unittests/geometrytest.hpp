@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "geometry.hpp"
+#include "graph_algorithms.hpp"
+#include <random>
+
+TEST(geometry, orient3d)
+{
+    std::array<double, 3> const a{0.0, 0.0, 0.0}, b{1.0, 0.0, 0.0}, c{0.0, 1.0, 0.0};
+
+    ASSERT_EQ(1, graph_lib::orient3d(b, c, std::array<double, 3>{0.0, 0.0, 1.0}, a));
+    ASSERT_EQ(-1, graph_lib::orient3d(c, b, std::array<double, 3>{0.0, 0.0, 1.0}, a));
+    ASSERT_EQ(0, graph_lib::orient3d(a, b, c, std::array<double, 3>{0.3, 0.7, 0.0}));
+
+    // points on the line x = y = z with coordinates that aren't representable, the floating point
+    // determinant is noise, the exact one decides them correctly
+    auto const x = 0.1, y = 0.2, z = 0.3;
+    std::array<double, 3> const p{x, x, x}, q{y, y, y}, r{z, z, z};
+    ASSERT_EQ(0, graph_lib::orient3d(p, q, r, std::array<double, 3>{1.0, 2.0, 3.0}));
+
+    // nearly coplanar point, just above and just below the plane z = x + y of the three points
+    std::array<double, 3> const u{1.0, 0.0, 1.0}, v{0.0, 1.0, 1.0}, w{1.0, 1.0, 2.0};
+    auto const above = std::nextafter(0.75, 1.0), below = std::nextafter(0.75, 0.0);
+    ASSERT_EQ(-graph_lib::orient3d(u, v, w, std::array<double, 3>{0.25, 0.5, below}),
+               graph_lib::orient3d(u, v, w, std::array<double, 3>{0.25, 0.5, above}));
+    ASSERT_EQ(0, graph_lib::orient3d(u, v, w, std::array<double, 3>{0.25, 0.5, 0.75}));
+}
+
+TEST(geometry, measure_tetrahedra)
+{
+    // cone triangulation of the octahedron from its inner point, the volume of the octahedron is 4/3
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B','C','D','E'} },
+                                           std::pair{'B', std::vector{'A','C','E','F'} },
+                                           std::pair{'C', std::vector{'A','B','D','F'} },
+                                           std::pair{'D', std::vector{'A','C','E','F'} },
+                                           std::pair{'E', std::vector{'A','B','D','F'} },
+                                           std::pair{'F', std::vector{'B','C','D','E'} },
+                                           std::pair{'Q', std::vector<char>{} }
+                                         }
+                            };
+    auto const position = g.add_vertex_property<std::array<double, 3>>();
+    g.set_vertex_value(position, 'A', {0.0, 0.0, 1.0});
+    g.set_vertex_value(position, 'B', {1.0, 0.0, 0.0});
+    g.set_vertex_value(position, 'C', {0.0, 1.0, 0.0});
+    g.set_vertex_value(position, 'D', {-1.0, 0.0, 0.0});
+    g.set_vertex_value(position, 'E', {0.0, -1.0, 0.0});
+    g.set_vertex_value(position, 'F', {0.0, 0.0, -1.0});
+    g.set_vertex_value(position, 'Q', {0.125, -0.25, 0.0625});
+
+    std::vector<std::tuple<char,char,char>> faces{};
+    for (auto const & [u, v, w] : graph_lib::find_triangles(graph_lib::compressed_graph<char>{g}))
+    {
+        if (u != 'Q' && v != 'Q' && w != 'Q')
+        {
+            faces.emplace_back(u, v, w);
+        }
+    }
+    auto const S = graph_lib::cone_triangulation(faces, 'Q');
+    auto const measures = graph_lib::measure_tetrahedra(g, position, S);
+
+    ASSERT_EQ(8, measures.volumes.size());
+    ASSERT_NEAR(4.0 / 3.0, measures.absolute_volume, 1e-12);
+    ASSERT_EQ(0, measures.exact_evaluations);
+    for (std::size_t i = 0; i < S.size(); ++i)
+    {
+        ASSERT_EQ(measures.volumes[i] > 0 ? 1 : -1, measures.orientations[i]);
+        auto const & [q, u, v, w] = S[i];
+        ASSERT_NEAR((g.vertex_value(position, q)[2] + g.vertex_value(position, u)[2] +
+                     g.vertex_value(position, v)[2] + g.vertex_value(position, w)[2]) / 4, measures.centroids[i][2], 1e-15);
+    }
+}
+
+TEST(geometry, measure_tetrahedra_kernels)
+{
+    // random tetrahedra mixed with the degenerate ones, both kernels agree with the exact predicate
+    std::mt19937_64 generator{7};
+    std::uniform_real_distribution<double> coordinate{-1.0, 1.0};
+
+    std::vector<std::array<double, 3>> points{};
+    for (int i = 0; i < 400; ++i)
+    {
+        points.push_back({coordinate(generator), coordinate(generator), coordinate(generator)});
+    }
+    // every fourth point lies on the line through the previous two
+    for (std::size_t i = 3; i < points.size(); i += 4)
+    {
+        auto const & a = points[i - 2];
+        auto const & b = points[i - 1];
+        points[i] = {a[0] + 3 * (b[0] - a[0]), a[1] + 3 * (b[1] - a[1]), a[2] + 3 * (b[2] - a[2])};
+    }
+
+    std::uniform_int_distribution<std::size_t> pick{0, points.size() - 1};
+    std::vector<std::array<std::size_t, 4>> T{};
+    for (std::size_t i = 0; i + 3 < points.size(); i += 2)
+    {
+        T.push_back({pick(generator), i, i + 1, i + 3});
+    }
+    T.push_back({0, 1, 2, 0});
+
+    auto const measures = graph_lib::measure_tetrahedra(points, T);
+    graph_lib::tetrahedra_measures scalar{std::vector<double>(T.size()), std::vector<int>(T.size()),
+                                          std::vector<std::array<double, 3>>(T.size()), 0.0, 0.0, 0};
+    graph_lib::detail::measure_tetrahedra_scalar(points, T, 0, scalar);
+
+    ASSERT_GT(measures.exact_evaluations, 0);
+    ASSERT_EQ(scalar.exact_evaluations, measures.exact_evaluations);
+    ASSERT_EQ(scalar.volumes, measures.volumes);
+    ASSERT_EQ(scalar.centroids, measures.centroids);
+    ASSERT_EQ(scalar.orientations, measures.orientations);
+    for (std::size_t i = 0; i < T.size(); ++i)
+    {
+        auto const & t = T[i];
+        ASSERT_EQ(graph_lib::orient3d(points[t[1]], points[t[2]], points[t[3]], points[t[0]]), measures.orientations[i]);
+    }
+    ASSERT_EQ(0, measures.orientations.back());
+}
@@ -1,7 +1,19 @@
 #include <gtest/gtest.h>
 #include "directedgraphtest.hpp"
 #include "algorithmstest.hpp"
+#include "compressedgraphtest.hpp"
+#include "externaltest.hpp"
+#include "planaritytest.hpp"
+#include "iotest.hpp"
+#include "partitioningtest.hpp"
+#include "analyticstest.hpp"
+#include "geometrytest.hpp"
 #include "graph.hpp"
+#include "mutation_batch.hpp"
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <random>
 
 // included only in case some debug lines are needed
 //#include <iostream>
@@ -191,6 +203,588 @@ TEST(graph, are_adjacent)
 
 }
 
+TEST(graph, snapshot)
+{
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B','C'} },
+                                           std::pair{'B', std::vector{'A','C'} },
+                                           std::pair{'C', std::vector{'A','B'} },
+                                           std::pair{'D', std::vector<char>{} }
+                                         }
+                            };
+
+    auto snapshot = g.snapshot();
+
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        // empty lists are never allocated, so there is nothing to share
+        ASSERT_EQ(it->first != 'D', it->second.shared());
+    }
+
+    snapshot.remove_edge('A', 'B');
+
+    ASSERT_EQ(2, snapshot.num_edges());
+    ASSERT_EQ(3, g.num_edges());
+    ASSERT_EQ(true, g.are_adjacent('A', 'B'));
+    ASSERT_EQ(false, snapshot.are_adjacent('A', 'B'));
+
+    // only the lists of A and B were copied, C still shares its list
+    ASSERT_EQ(false, g.cbegin()->second.shared());
+    ASSERT_EQ(true, std::next(g.cbegin(), 2)->second.shared());
+
+    snapshot.insert_edge('A', 'D');
+    ASSERT_EQ(0, g.degree('D'));
+    ASSERT_EQ(1, snapshot.degree('D'));
+
+    g.remove_vertex('D');
+    ASSERT_EQ(4, snapshot.num_vertices());
+    ASSERT_EQ(3, g.num_vertices());
+}
+
+TEST(graph, version)
+{
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B'} },
+                                           std::pair{'B', std::vector{'A'} }
+                                         }
+                            };
+
+    ASSERT_EQ(0, g.version());
+    g.insert_vertex('C');
+    g.insert_edge('A', 'C');
+    ASSERT_EQ(2, g.version());
+    g.remove_edge('A', 'C');
+    g.remove_vertex('C');
+    g.sort_vertices_by_degree();
+    ASSERT_EQ(5, g.version());
+
+    // queries don't modify the graph
+    ASSERT_EQ(1, g.degree('A'));
+    ASSERT_EQ(5, g.version());
+
+    // copies are different graphs, even if they start from the same version
+    auto snapshot = g.snapshot();
+    ASSERT_NE(g.id(), snapshot.id());
+    ASSERT_EQ(g.version(), snapshot.version());
+
+    graph_lib::graph<char> other{};
+    auto const id = other.id();
+    other = g;
+    ASSERT_NE(g.id(), other.id());
+    ASSERT_NE(id, other.id());
+}
+
+// vertex type without operator<
+struct unordered_vertex
+{
+    int value;
+
+    bool operator==(unordered_vertex const & other) const { return value == other.value; }
+};
+
+template <>
+struct std::hash<unordered_vertex>
+{
+    std::size_t operator()(unordered_vertex const & vertex) const { return std::hash<int>{}(vertex.value); }
+};
+
+TEST(graph, views)
+{
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B','C'} },
+                                           std::pair{'B', std::vector{'A','C'} },
+                                           std::pair{'C', std::vector{'A','B','D'} },
+                                           std::pair{'D', std::vector{'C'} },
+                                           std::pair{'E', std::vector<char>{} }
+                                         }
+                            };
+
+    auto const vertices = g.vertices();
+    ASSERT_EQ((std::vector{'A','B','C','D','E'}), std::vector<char>(std::begin(vertices), std::end(vertices)));
+
+    // every undirected edge exactly once
+    std::vector<std::pair<char,char>> edges{};
+    for (auto const [source, target] : g.edges())
+    {
+        edges.emplace_back(source, target);
+    }
+    ASSERT_EQ(g.num_edges(), edges.size());
+    ASSERT_EQ((std::vector{ std::pair{'A','B'}, std::pair{'A','C'}, std::pair{'B','C'}, std::pair{'C','D'} }), edges);
+
+    auto const incident = g.incident_edges('C');
+    ASSERT_EQ(3, std::distance(std::begin(incident), std::end(incident)));
+    for (auto const e : incident)
+    {
+        ASSERT_EQ('C', e.source());
+        ASSERT_EQ(e.target(), g.opposite('C', e));
+        ASSERT_EQ('C', g.opposite(e.target(), e));
+    }
+    ASSERT_EQ(true, g.incident_edges('E').empty());
+    ASSERT_EQ(1, std::count_if(std::begin(g.edges()), std::end(g.edges()),
+                               [](auto const e){ return e == graph_lib::edge<char>{'D', 'C'}; }));
+
+    graph_lib::graph<std::string> named{std::vector { std::pair{std::string{"b"}, std::vector<std::string>{"a"} },
+                                                      std::pair{std::string{"a"}, std::vector<std::string>{"b"} }
+                                                    }
+                                       };
+    auto const named_edges = named.edges();
+    ASSERT_EQ(1, std::distance(std::begin(named_edges), std::end(named_edges)));
+    ASSERT_EQ("a", (*std::begin(named_edges)).source());
+
+    // vertices without operator< are ordered by their position
+    graph_lib::graph<unordered_vertex> unordered{std::vector { std::pair{unordered_vertex{2}, std::vector{unordered_vertex{1}} },
+                                                               std::pair{unordered_vertex{1}, std::vector{unordered_vertex{2}} }
+                                                             }
+                                                };
+    auto const unordered_edges = unordered.edges();
+    ASSERT_EQ(1, std::distance(std::begin(unordered_edges), std::end(unordered_edges)));
+    ASSERT_EQ(2, (*std::begin(unordered_edges)).source().value);
+
+    // directed graph reports every arc
+    graph_lib::graph<int, false> directed{std::vector { std::pair{1, std::vector{2} },
+                                                        std::pair{2, std::vector{1} }
+                                                      }
+                                         };
+    auto const arcs = directed.edges();
+    ASSERT_EQ(2, std::distance(std::begin(arcs), std::end(arcs)));
+}
+
+TEST(graph, default_initialized)
+{
+    // default initialization over dirty memory, the counters and the reserved degree start from zero
+    alignas(graph_lib::graph<int>) unsigned char storage[sizeof(graph_lib::graph<int>)];
+    std::memset(storage, 0xAB, sizeof(storage));
+    auto * const g = new (storage) graph_lib::graph<int>;
+
+    ASSERT_EQ(0, g->num_edges());
+    ASSERT_EQ(0, g->version());
+    g->insert_vertex(1);
+    g->insert_vertex(2);
+    g->insert_edge(1, 2);
+    ASSERT_EQ(1, g->num_edges());
+    ASSERT_EQ(3, g->version());
+
+    g->~graph();
+}
+
+TEST(graph, capacity)
+{
+    graph_lib::graph<int> g{};
+    g.reserve_vertices(1000);
+    g.reserve_edges(3000);
+
+    auto const reserved = g.memory_usage();
+    ASSERT_EQ(1000 * sizeof(graph_lib::graph<int>::storage_type::value_type), reserved.vertices.allocated);
+    ASSERT_EQ(0, reserved.vertices.used);
+    ASSERT_GE(reserved.index.allocated, 1000 * sizeof(void *));
+
+    for (int v = 0; v < 1000; ++v)
+    {
+        g.insert_vertex(int{v});
+    }
+    for (int v = 0; v < 1000; ++v)
+    {
+        g.insert_edge(v, (v + 1) % 1000);
+    }
+
+    // storage wasn't reallocated and every list got the room for the average degree of 6 on its first edge
+    ASSERT_EQ(reserved.vertices.allocated, g.memory_usage().vertices.allocated);
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        ASSERT_EQ(6, it->second.capacity());
+    }
+
+    g.reserve_edges(7, 100);
+    ASSERT_EQ(100, std::next(g.cbegin(), 7)->second.capacity());
+
+    // lists shared with the snapshot keep their capacity
+    {
+        auto const snapshot = g.snapshot();
+        g.shrink_to_fit();
+        ASSERT_EQ(100, std::next(g.cbegin(), 7)->second.capacity());
+    }
+
+    g.remove_edge(0, 1);
+    g.shrink_to_fit();
+
+    auto const usage = g.memory_usage();
+    auto const block_overhead = sizeof(std::vector<int>) + 2 * sizeof(void *);
+    ASSERT_EQ(usage.vertices.used, usage.vertices.allocated);
+    ASSERT_EQ(usage.neighbors.used, usage.neighbors.allocated);
+    ASSERT_EQ(1000 * block_overhead + 2 * g.num_edges() * sizeof(int), usage.neighbors.used);
+    ASSERT_EQ(usage.total().used, usage.vertices.used + usage.neighbors.used + usage.index.used);
+
+    // removed edges don't leave empty blocks behind
+    g.remove_edge(999, 0);
+    g.shrink_to_fit();
+    ASSERT_EQ(nullptr, g.cbegin()->second.block());
+}
+
+TEST(graph, properties)
+{
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B','C'} },
+                                           std::pair{'B', std::vector{'A','C'} },
+                                           std::pair{'C', std::vector{'A','B','D'} },
+                                           std::pair{'D', std::vector{'C'} }
+                                         }
+                            };
+
+    auto const position = g.add_vertex_property<double>(-1.0);
+    auto const length   = g.add_edge_property<float>();
+
+    ASSERT_EQ(std::vector<double>(4, -1.0), g.vertex_values(position));
+    auto & values = g.mutable_vertex_values(position);
+    std::iota(std::begin(values), std::end(values), 0.0);
+    ASSERT_EQ(2.0, g.vertex_value(position, 'C'));
+
+    // undirected edge has the value on both ends, parallel to the neighbor lists
+    g.set_edge_value(length, 'C', 'D', 2.5f);
+    ASSERT_EQ(2.5f, g.edge_value(length, 'D', 'C'));
+    ASSERT_EQ((std::vector<float>{0.0f, 0.0f, 2.5f}), g.edge_values(length, 'C'));
+
+    // the copy shares the columns until one of the graphs modifies them
+    auto const snapshot = g.snapshot();
+
+    g.insert_vertex('E');
+    g.insert_edge('E', 'A');
+    g.set_vertex_value(position, 'E', 4.0);
+    g.set_edge_value(length, 'A', 'E', 1.5f);
+    ASSERT_EQ((std::vector<double>{0.0, 1.0, 2.0, 3.0, 4.0}), g.vertex_values(position));
+    ASSERT_EQ((std::vector<float>{0.0f, 0.0f, 1.5f}), g.edge_values(length, 'A'));
+    ASSERT_EQ(4, snapshot.vertex_values(position).size());
+    ASSERT_EQ(2, snapshot.edge_values(length, 'A').size());
+
+    // removals keep the columns aligned with the slots and the neighbor lists
+    g.remove_edge('A', 'B');
+    ASSERT_EQ((std::vector<float>{0.0f, 1.5f}), g.edge_values(length, 'A'));
+    g.remove_vertex('C');
+    ASSERT_EQ((std::vector<double>{0.0, 1.0, 3.0, 4.0}), g.vertex_values(position));
+    ASSERT_EQ(std::vector<float>{}, g.edge_values(length, 'D'));
+    ASSERT_EQ(1.5f, g.edge_value(length, 'E', 'A'));
+    ASSERT_EQ(2.5f, snapshot.edge_value(length, 'C', 'D'));
+
+    // reordering moves the values with the vertices
+    g.insert_edge('B', 'D');
+    g.set_edge_value(length, 'D', 'B', 7.0f);
+    g.sort_vertices_by_degree();
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        auto const slot = static_cast<std::size_t>(std::distance(g.cbegin(), it));
+        ASSERT_EQ(static_cast<double>(std::string{"ABCDE"}.find(it->first)), g.vertex_values(position)[slot]);
+        ASSERT_EQ(it->second.size(), g.edge_values(length, it->first).size());
+    }
+    ASSERT_EQ(7.0f, g.edge_value(length, 'B', 'D'));
+
+    ASSERT_GE(g.memory_usage().properties.used, 4 * sizeof(double) + 6 * sizeof(float));
+}
+
+TEST(graph, validating_constructor)
+{
+    using report_type = graph_lib::validation_report<char>;
+    using kind = report_type::kind;
+
+    report_type report{};
+    graph_lib::graph<char> valid{std::vector { std::pair{'A', std::vector{'B','C'} },
+                                               std::pair{'B', std::vector{'A','C'} },
+                                               std::pair{'C', std::vector{'A','B'} }
+                                             },
+                                 report
+                                };
+
+    ASSERT_EQ(true, report.valid());
+    ASSERT_EQ(3, valid.num_vertices());
+    ASSERT_EQ(3, valid.num_edges());
+
+    std::vector adjacency{ std::pair{'A', std::vector{'B','C','A'} },
+                           std::pair{'B', std::vector{'A','C','C'} },
+                           std::pair{'C', std::vector{'B','X'} },
+                           std::pair{'A', std::vector<char>{} }
+                         };
+    graph_lib::graph<char> invalid{std::move(adjacency), report};
+
+    std::vector<report_type::violation> expected{ {kind::duplicate_vertex,  'A', 'A'},
+                                                  {kind::self_loop,         'A', 'A'},
+                                                  {kind::repeated_neighbor, 'B', 'C'},
+                                                  {kind::unknown_vertex,    'C', 'X'},
+                                                  {kind::asymmetric_edge,   'A', 'C'} };
+
+    ASSERT_EQ(false, report.valid());
+    ASSERT_EQ(expected, report.violations);
+    ASSERT_EQ(0, invalid.num_vertices());
+    ASSERT_EQ(0, invalid.num_edges());
+    // rejected input is left to the caller
+    ASSERT_EQ(4, std::size(adjacency));
+
+    graph_lib::graph<char, false> directed{std::vector { std::pair{'A', std::vector{'B'} },
+                                                         std::pair{'B', std::vector<char>{} }
+                                                       },
+                                           report
+                                          };
+    ASSERT_EQ(true, report.valid());
+    ASSERT_EQ(1, directed.num_edges());
+}
+
+TEST(graph, validating_constructor_large)
+{
+    // cycle with one broken link, big enough to be validated by several threads
+    constexpr int vertices = 50000;
+    graph_lib::graph<int>::graph_vector_type adjacency{};
+    for (int i = 0; i < vertices; ++i)
+    {
+        adjacency.emplace_back(std::pair{i, std::vector<int>{(i + 1) % vertices, (i + vertices - 1) % vertices}});
+    }
+    adjacency[777].second[0] = 779;
+
+    graph_lib::validation_report<int> report{};
+    graph_lib::graph<int> g{std::move(adjacency), report};
+
+    using kind = graph_lib::validation_report<int>::kind;
+    std::vector<graph_lib::validation_report<int>::violation> expected{ {kind::asymmetric_edge, 777, 779},
+                                                                        {kind::asymmetric_edge, 778, 777} };
+    ASSERT_EQ(expected, report.violations);
+}
+
+TEST(graph, batched_queries)
+{
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B','C'} },
+                                           std::pair{'B', std::vector{'A','C'} },
+                                           std::pair{'C', std::vector{'A','B'} },
+                                           std::pair{'D', std::vector<char>{} }
+                                         }
+                            };
+
+    std::vector vertices{'C', 'D', 'A', 'C'};
+    std::vector<std::size_t> degrees(vertices.size());
+    g.degree(std::cbegin(vertices), std::cend(vertices), std::begin(degrees));
+    ASSERT_EQ((std::vector<std::size_t>{2, 0, 2, 2}), degrees);
+
+    std::vector pairs{ std::pair{'A','B'}, std::pair{'D','A'}, std::pair{'C','A'}, std::pair{'A','D'} };
+    std::vector<bool> adjacent{};
+    g.are_adjacent(std::cbegin(pairs), std::cend(pairs), std::back_inserter(adjacent));
+    ASSERT_EQ((std::vector<bool>{true, false, true, false}), adjacent);
+
+    // slots of the vertices after the removed one are shifted
+    g.remove_vertex('B');
+    ASSERT_EQ(2, g.vertex_index().at('D'));
+    ASSERT_EQ(0, g.degree('D'));
+    ASSERT_EQ(1, g.degree('A'));
+
+    std::vector missing{ std::pair{'A','B'} };
+    ASSERT_DEATH(g.are_adjacent(std::cbegin(missing), std::cend(missing), std::back_inserter(adjacent)),
+                 "Assertion `\\(it == std::c?end\\(_adjacency_list\\)\\) != flag' failed\\.");
+}
+
+TEST(graph, batched_queries_large)
+{
+    // wheel, the hub is queried often enough to take the sorted lookup
+    constexpr int rim = 1000;
+    graph_lib::graph<int>::graph_vector_type adjacency{ std::pair{rim, std::vector<int>{}} };
+    for (int i = 0; i < rim; ++i)
+    {
+        adjacency[0].second.emplace_back(i);
+        adjacency.emplace_back(std::pair{i, std::vector<int>{(i + 1) % rim, (i + rim - 1) % rim, rim}});
+    }
+    graph_lib::graph<int> g{std::move(adjacency)};
+
+    std::vector<std::pair<int, int>> pairs{};
+    for (int i = 0; i < rim; ++i)
+    {
+        pairs.emplace_back(rim, i);
+        pairs.emplace_back(i, (i + 2) % rim);
+        pairs.emplace_back(i, (i + 1) % rim);
+    }
+
+    std::vector<bool> batched{};
+    g.are_adjacent(std::cbegin(pairs), std::cend(pairs), std::back_inserter(batched));
+
+    ASSERT_EQ(pairs.size(), batched.size());
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+    {
+        ASSERT_EQ(g.are_adjacent(pairs[i].first, pairs[i].second), batched[i]);
+    }
+}
+
+// checks that the graphs have the same vertices in the same order and the same neighbors
+template <typename V>
+void assert_same_graph(graph_lib::graph<V> const & expected, graph_lib::graph<V> const & actual)
+{
+    ASSERT_EQ(expected.num_vertices(), actual.num_vertices());
+    ASSERT_EQ(expected.num_edges(), actual.num_edges());
+    for (auto first = expected.cbegin(), second = actual.cbegin(); first != expected.cend(); ++first, ++second)
+    {
+        ASSERT_EQ(first->first, second->first);
+        std::vector<V> expected_neighbors{std::cbegin(first->second), std::cend(first->second)};
+        std::vector<V> actual_neighbors{std::cbegin(second->second), std::cend(second->second)};
+        std::sort(std::begin(expected_neighbors), std::end(expected_neighbors));
+        std::sort(std::begin(actual_neighbors), std::end(actual_neighbors));
+        ASSERT_EQ(expected_neighbors, actual_neighbors);
+    }
+}
+
+TEST(graph, mutation_batch)
+{
+    graph_lib::graph<char> g{std::vector { std::pair{'A', std::vector{'B','C'} },
+                                           std::pair{'B', std::vector{'A','C'} },
+                                           std::pair{'C', std::vector{'A','B','D'} },
+                                           std::pair{'D', std::vector{'C'} }
+                                         }
+                            };
+    auto const length = g.add_edge_property<float>();
+    g.set_edge_value(length, 'A', 'C', 3.0f);
+    auto const snapshot = g.snapshot();
+
+    graph_lib::mutation_batch<char> batch{};
+    batch.insert_vertex('E');
+    batch.insert_edge('E', 'A');
+    batch.insert_edge('E', 'B');
+    batch.remove_edge('B', 'E');
+    batch.insert_vertex('F');
+    batch.remove_vertex('F');
+    batch.remove_edge('A', 'C');
+    batch.insert_edge('C', 'A');
+    batch.remove_vertex('D');
+    batch.remove_edge('A', 'B');
+    ASSERT_EQ(10, batch.size());
+    ASSERT_EQ(true, batch.consistent());
+
+    auto expected = g.snapshot();
+    expected.insert_vertex('E');
+    expected.insert_edge('E', 'A');
+    expected.remove_vertex('D');
+    expected.remove_edge('A', 'B');
+
+    auto const version = g.version();
+    ASSERT_EQ(true, g.apply(batch));
+    assert_same_graph(expected, g);
+    ASSERT_EQ(version + 1, g.version());
+
+    // the edge removed and inserted again is left alone, the columns follow the lists
+    ASSERT_EQ(3.0f, g.edge_value(length, 'C', 'A'));
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        ASSERT_EQ(it->second.size(), g.edge_values(length, it->first).size());
+    }
+    ASSERT_EQ(4, snapshot.num_vertices());
+    ASSERT_EQ(4, snapshot.num_edges());
+
+    // the batch is rejected as a whole when G doesn't agree with it
+    graph_lib::mutation_batch<char> invalid{};
+    invalid.remove_vertex('E');
+    invalid.insert_edge('A', 'C');
+    ASSERT_EQ(true, invalid.consistent());
+    ASSERT_EQ(false, g.apply(invalid));
+    assert_same_graph(expected, g);
+    ASSERT_EQ(version + 1, g.version());
+
+    // the edge inserted and removed again still has to be missing from G
+    invalid.clear();
+    invalid.insert_edge('A', 'C');
+    invalid.remove_edge('A', 'C');
+    ASSERT_EQ(false, g.apply(invalid));
+
+    // operations that can't follow each other are caught while they are recorded
+    invalid.clear();
+    invalid.insert_vertex('G');
+    invalid.insert_vertex('G');
+    ASSERT_EQ(false, invalid.consistent());
+    invalid.clear();
+    invalid.insert_vertex('G');
+    invalid.remove_edge('G', 'A');
+    ASSERT_EQ(false, invalid.consistent());
+    invalid.clear();
+    invalid.remove_vertex('A');
+    invalid.insert_edge('A', 'C');
+    ASSERT_EQ(false, invalid.consistent());
+    ASSERT_EQ(false, g.apply(invalid));
+
+    // the vertex removed and inserted again loses its edges and moves to the end
+    graph_lib::mutation_batch<char> again{};
+    again.remove_edge('B', 'C');
+    again.remove_vertex('C');
+    again.insert_vertex('C');
+    again.insert_edge('C', 'E');
+    ASSERT_EQ(true, g.apply(again));
+    expected.remove_edge('B', 'C');
+    expected.remove_vertex('C');
+    expected.insert_vertex('C');
+    expected.insert_edge('C', 'E');
+    assert_same_graph(expected, g);
+}
+
+TEST(graph, mutation_batch_large)
+{
+    std::mt19937_64 generator{11};
+    auto const pick = [&](std::size_t count){ return std::uniform_int_distribution<std::size_t>{0, count - 1}(generator); };
+
+    // the ring with the hub, the expected graph gets the same operations one by one
+    graph_lib::graph<int>::graph_vector_type adjacency{};
+    int const rim = 500;
+    adjacency.emplace_back(std::pair{rim, std::vector<int>{}});
+    for (int i = 0; i < rim; ++i)
+    {
+        adjacency[0].second.emplace_back(i);
+        adjacency.emplace_back(std::pair{i, std::vector<int>{(i + 1) % rim, (i + rim - 1) % rim, rim}});
+    }
+    graph_lib::graph<int> g{std::move(adjacency)};
+    (void) g.add_edge_property<int>(-1);
+    auto expected = g.snapshot();
+
+    std::vector<int> present(rim + 1);
+    std::iota(std::begin(present), std::end(present), 0);
+    int next_vertex = rim + 1;
+
+    graph_lib::mutation_batch<int> batch{};
+    for (int operation = 0; operation < 5000; ++operation)
+    {
+        auto const kind = pick(10);
+        if (kind == 0 || present.size() < 3)
+        {
+            // removed vertices come back every now and then
+            auto const vertex = pick(2) == 0 && next_vertex > rim + 1 ? static_cast<int>(pick(static_cast<std::size_t>(next_vertex)))
+                                                                      : next_vertex++;
+            if (std::find(std::cbegin(present), std::cend(present), vertex) == std::cend(present))
+            {
+                batch.insert_vertex(vertex);
+                expected.insert_vertex(int{vertex});
+                present.emplace_back(vertex);
+            }
+        }
+        else if (kind == 1)
+        {
+            auto const position = pick(present.size());
+            batch.remove_vertex(present[position]);
+            expected.remove_vertex(present[position]);
+            present.erase(std::next(std::begin(present), static_cast<std::ptrdiff_t>(position)));
+        }
+        else if (kind < 6)
+        {
+            auto const first  = present[pick(present.size())];
+            auto const second = present[pick(present.size())];
+            if (first != second && !expected.are_adjacent(first, second))
+            {
+                batch.insert_edge(first, second);
+                expected.insert_edge(first, second);
+            }
+        }
+        else
+        {
+            auto const first = present[pick(present.size())];
+            auto const & neighbors = expected.adjacent_vertices(first);
+            if (!neighbors.empty())
+            {
+                auto const second = neighbors[pick(neighbors.size())];
+                batch.remove_edge(first, second);
+                expected.remove_edge(first, second);
+            }
+        }
+    }
+
+    ASSERT_EQ(true, batch.consistent());
+    ASSERT_EQ(true, g.apply(batch));
+    assert_same_graph(expected, g);
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        ASSERT_EQ(it->second.size(), g.edge_values(graph_lib::edge_property<int>{0}, it->first).size());
+    }
+}
+
 int main(int argc, char ** argv)
 {
     testing::InitGoogleTest(&argc, argv);
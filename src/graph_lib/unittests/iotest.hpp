@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <cstdio>
+#include <cstdint>
+
+#include "graph_io.hpp"
+#include "bounded_queue.hpp"
+
+TEST(io, read_off)
+{
+    // square pyramid, the base is a quad
+    std::istringstream input{"OFF\n"
+                             "# comment\n"
+                             "5 5 8\n"
+                             "0 0 0\n1 0 0\n1 1 0\n0 1 0\n0.5 0.5 1\n"
+                             "4 0 3 2 1\n"
+                             "3 0 1 4\n3 1 2 4\n3 2 3 4\n3 3 0 4 255 0 0\n"};
+
+    auto const adjacency = graph_lib::read_off<int>(input);
+    ASSERT_EQ(true, adjacency.has_value());
+
+    graph_lib::validation_report<int> report{};
+    graph_lib::graph<int> g{graph_lib::graph<int>::graph_vector_type{*adjacency}, report};
+    ASSERT_EQ(true, report.valid());
+    ASSERT_EQ(5, g.num_vertices());
+    ASSERT_EQ(8, g.num_edges());
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3}), g.adjacent_vertices(4));
+    ASSERT_EQ((std::vector<int>{1, 3, 4}), g.adjacent_vertices(0));
+
+    std::istringstream out_of_range{"OFF\n3 1 3\n0 0 0\n1 0 0\n0 1 0\n3 0 1 3\n"};
+    ASSERT_EQ(false, graph_lib::read_off<int>(out_of_range).has_value());
+
+    std::istringstream truncated{"OFF 3 1 3\n0 0 0\n1 0 0\n"};
+    ASSERT_EQ(false, graph_lib::read_off<int>(truncated).has_value());
+}
+
+TEST(io, read_edge_list)
+{
+    std::istringstream input{"# triangle with a tail\n"
+                             "10 20\n"
+                             "20 30\n"
+                             "\n"
+                             "30 10\n"
+                             "30 40\n"};
+
+    auto const adjacency = graph_lib::read_edge_list<int>(input);
+    ASSERT_EQ(true, adjacency.has_value());
+
+    graph_lib::graph<int> g{*adjacency};
+    ASSERT_EQ(4, g.num_vertices());
+    ASSERT_EQ(4, g.num_edges());
+    ASSERT_EQ(10, g.cbegin()->first);
+    ASSERT_EQ((std::vector<int>{20, 10, 40}), g.adjacent_vertices(30));
+
+    std::istringstream malformed{"1 2\n3\n"};
+    ASSERT_EQ(false, graph_lib::read_edge_list<int>(malformed).has_value());
+}
+
+TEST(io, bounded_queue)
+{
+    graph_lib::bounded_queue<int> queue{2};
+
+    std::thread producer{[&]
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            ASSERT_EQ(true, queue.push(i));
+        }
+        queue.close();
+    }};
+
+    int expected{};
+    while (auto item = queue.pop())
+    {
+        ASSERT_EQ(expected++, *item);
+    }
+    producer.join();
+
+    ASSERT_EQ(1000, expected);
+    ASSERT_EQ(false, queue.push(0));
+    ASSERT_EQ(false, queue.pop().has_value());
+}
+
+TEST(io, write_text)
+{
+    graph_lib::graph<int> g{std::vector { std::pair{10, std::vector{20, 30} },
+                                          std::pair{20, std::vector{10, 30} },
+                                          std::pair{30, std::vector{10, 20, 40} },
+                                          std::pair{40, std::vector{30} }
+                                        }
+                           };
+
+    std::ostringstream text{};
+    {
+        graph_lib::output_buffer output{text};
+        graph_lib::write_edge_list(output, g);
+        ASSERT_EQ(true, output.flush());
+    }
+    ASSERT_EQ("10 20\n10 30\n20 30\n30 40\n", text.str());
+
+    // written edge list is read back into the same graph
+    std::istringstream input{text.str()};
+    graph_lib::graph<int> read{*graph_lib::read_edge_list<int>(input)};
+    ASSERT_EQ(g.num_edges(), read.num_edges());
+    for (auto it = g.cbegin(); it != g.cend(); ++it)
+    {
+        for (auto const & neighbor : it->second)
+        {
+            ASSERT_EQ(true, read.are_adjacent(it->first, neighbor));
+        }
+    }
+
+    std::ostringstream triangles{};
+    {
+        graph_lib::output_buffer output{triangles};
+        graph_lib::write_triangles(output, std::vector{std::tuple{'A', 'B', 'C'}});
+        graph_lib::write_tetrahedra(output, std::vector{std::tuple{std::string{"Q"}, std::string{"A1"}, std::string{"B"}, std::string{"C"}}});
+    }
+    ASSERT_EQ("A B C\nQ A1 B C\n", triangles.str());
+
+    std::ostringstream ele{};
+    {
+        graph_lib::output_buffer output{ele};
+        graph_lib::write_tetgen_ele(output, std::vector{std::tuple{0, 1, 2, 3}, std::tuple{0, 2, 3, 4}});
+    }
+    ASSERT_EQ("2 4 0\n0 0 1 2 3\n1 0 2 3 4\n", ele.str());
+
+    std::ostringstream node{};
+    {
+        graph_lib::output_buffer output{node};
+        graph_lib::write_tetgen_node(output, std::vector{std::array{0.5, -1.0, 2.25}});
+    }
+    ASSERT_EQ("1 3 0 0\n0 0.5 -1 2.25\n", node.str());
+}
+
+TEST(io, write_binary)
+{
+    // enough tetrahedra to fill several chunks of the buffer
+    std::vector<std::tuple<std::int32_t, std::int32_t, std::int32_t, std::int32_t>> tetrahedra{};
+    for (std::int32_t i = 0; i < 100000; ++i)
+    {
+        tetrahedra.emplace_back(0, i, i + 1, i + 2);
+    }
+
+    auto * file = std::tmpfile();
+    ASSERT_NE(nullptr, file);
+    {
+        graph_lib::output_buffer output{fileno(file)};
+        graph_lib::write_binary(output, tetrahedra);
+        ASSERT_EQ(true, output.flush());
+    }
+
+    std::rewind(file);
+    char magic[4]{};
+    std::uint32_t header[3]{};
+    std::uint64_t count{};
+    ASSERT_EQ(1, std::fread(magic, sizeof(magic), 1, file));
+    ASSERT_EQ(1, std::fread(header, sizeof(header), 1, file));
+    ASSERT_EQ(1, std::fread(&count, sizeof(count), 1, file));
+    ASSERT_EQ("GLB1", std::string(magic, 4));
+    ASSERT_EQ(4, header[0]);
+    ASSERT_EQ(4, header[1]);
+    ASSERT_EQ(tetrahedra.size(), count);
+
+    std::vector<std::int32_t> values(4 * tetrahedra.size());
+    ASSERT_EQ(values.size(), std::fread(values.data(), sizeof(std::int32_t), values.size(), file));
+    ASSERT_EQ(99999, values[4 * 99999 + 1]);
+    ASSERT_EQ(100001, values.back());
+    ASSERT_EQ(EOF, std::fgetc(file));
+    std::fclose(file);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "multiprocess.hpp"
+#include "compressed_graph.hpp"
+#include "testgraphs.hpp"
+
+TEST(partitioning, partition_graph)
+{
+    auto const g = make_triangulated_grid(60);
+    constexpr std::size_t parts = 6;
+
+    auto const partition = graph_lib::partition_graph(g, parts);
+    ASSERT_EQ(parts, partition.num_parts());
+
+    std::size_t owned{};
+    for (std::size_t part = 0; part < parts; ++part)
+    {
+        // balanced up to the slack of the refinement
+        ASSERT_LE(partition.owned[part].size(), 600 + 600 / 32 + 1);
+        ASSERT_GE(partition.owned[part].size(), 600 - 600 / 32 - 1);
+        owned += partition.owned[part].size();
+
+        for (auto const slot : partition.owned[part])
+        {
+            ASSERT_EQ(part, partition.part_of[slot]);
+        }
+        for (auto const slot : partition.ghosts[part])
+        {
+            ASSERT_NE(part, partition.part_of[slot]);
+        }
+    }
+    ASSERT_EQ(g.num_vertices(), owned);
+
+    // compact parts cut only a small fraction of the edges, splitting the grid into strips cuts ~5 * 3 * 60
+    ASSERT_LT(partition.cut_edges, g.num_edges() / 10);
+}
+
+TEST(partitioning, run_partitioned)
+{
+    auto const g = make_triangulated_grid(40);
+    auto const partition = graph_lib::partition_graph(g, 4);
+
+    std::vector<int> queries{0, 39, 800, 1599, 0};
+    auto const results = graph_lib::run_partitioned(g, partition, queries);
+    ASSERT_EQ(true, results.has_value());
+
+    auto expected = graph_lib::find_triangles(graph_lib::compressed_graph<int>{g});
+    for (auto & [u, v, w] : expected)
+    {
+        std::array<int, 3> corners{u, v, w};
+        std::sort(std::begin(corners), std::end(corners));
+        std::tie(u, v, w) = std::tuple{corners[0], corners[1], corners[2]};
+    }
+    std::sort(std::begin(expected), std::end(expected));
+    // vertices are their own slots, so the results come sorted the same way and without duplicates
+    ASSERT_EQ(expected, results->triangles);
+
+    ASSERT_EQ(queries.size(), results->degrees.size());
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        ASSERT_EQ(queries[i], results->degrees[i].first);
+        ASSERT_EQ(g.degree(queries[i]), results->degrees[i].second);
+    }
+
+    // the query of the vertex that isn't in the graph fails the whole run
+    ASSERT_EQ(false, graph_lib::run_partitioned(g, partition, std::vector<int>{0, 1600}).has_value());
+}
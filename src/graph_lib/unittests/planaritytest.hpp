@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+
+#include "planarity.hpp"
+
+namespace
+{
+    // builds an undirected graph with the vertices 0 ... n-1 from the list of edges
+    graph_lib::graph<int> make_graph(int vertices, std::vector<std::pair<int,int>> const & edges)
+    {
+        graph_lib::graph<int>::graph_vector_type adjacency{};
+        for (int v = 0; v < vertices; ++v)
+        {
+            adjacency.emplace_back(std::pair{v, std::vector<int>{}});
+        }
+        for (auto const & [a, b] : edges)
+        {
+            adjacency[static_cast<std::size_t>(a)].second.emplace_back(b);
+            adjacency[static_cast<std::size_t>(b)].second.emplace_back(a);
+        }
+        return graph_lib::graph<int>{std::move(adjacency)};
+    }
+
+    // prism over the n-gon, the graph of a convex polyhedron
+    graph_lib::graph<int> make_prism(int n)
+    {
+        std::vector<std::pair<int,int>> edges{};
+        for (int i = 0; i < n; ++i)
+        {
+            edges.emplace_back(i, (i + 1) % n);
+            edges.emplace_back(n + i, n + (i + 1) % n);
+            edges.emplace_back(i, n + i);
+        }
+        return make_graph(2 * n, edges);
+    }
+
+    // counts the faces traced by the rotation system
+    std::size_t count_faces(graph_lib::graph<int>::graph_vector_type const & embedding)
+    {
+        std::map<std::pair<int,int>, bool> visited{};
+        std::size_t faces{};
+        for (auto const & [u, neighbors] : embedding)
+        {
+            for (auto const v : neighbors)
+            {
+                if (visited[{u, v}])
+                {
+                    continue;
+                }
+                ++faces;
+                auto a = u;
+                auto b = v;
+                while (!visited[{a, b}])
+                {
+                    visited[{a, b}] = true;
+                    auto const & around = embedding[static_cast<std::size_t>(b)].second;
+                    auto const it = std::find(std::cbegin(around), std::cend(around), a);
+                    auto const next = std::next(it) == std::cend(around) ? std::cbegin(around) : std::next(it);
+                    a = b;
+                    b = *next;
+                }
+            }
+        }
+        return faces;
+    }
+}
+
+TEST(planarity, complete_graphs)
+{
+    auto const k4 = make_graph(4, {{0,1}, {0,2}, {0,3}, {1,2}, {1,3}, {2,3}});
+    ASSERT_EQ(true, graph_lib::is_planar(k4));
+    ASSERT_EQ(true, graph_lib::is_biconnected(k4));
+    ASSERT_EQ(true, graph_lib::is_polyhedral(k4));
+
+    auto const k5 = make_graph(5, {{0,1}, {0,2}, {0,3}, {0,4}, {1,2}, {1,3}, {1,4}, {2,3}, {2,4}, {3,4}});
+    ASSERT_EQ(false, graph_lib::is_planar(k5));
+    ASSERT_EQ(false, graph_lib::is_polyhedral(k5));
+    ASSERT_EQ(false, graph_lib::find_planar_embedding(k5).has_value());
+
+    auto const k33 = make_graph(6, {{0,3}, {0,4}, {0,5}, {1,3}, {1,4}, {1,5}, {2,3}, {2,4}, {2,5}});
+    ASSERT_EQ(false, graph_lib::is_planar(k33));
+}
+
+TEST(planarity, petersen)
+{
+    auto const petersen = make_graph(10, {{0,1}, {1,2}, {2,3}, {3,4}, {4,0},
+                                          {0,5}, {1,6}, {2,7}, {3,8}, {4,9},
+                                          {5,7}, {7,9}, {9,6}, {6,8}, {8,5}});
+    ASSERT_EQ(false, graph_lib::is_planar(petersen));
+    ASSERT_EQ(false, graph_lib::is_polyhedral(petersen));
+}
+
+TEST(planarity, embedding)
+{
+    for (int n : {3, 4, 10, 2000})
+    {
+        auto const prism = make_prism(n);
+        auto const embedding = graph_lib::find_planar_embedding(prism);
+
+        ASSERT_EQ(true, embedding.has_value());
+        // V - E + F = 2
+        ASSERT_EQ(static_cast<std::size_t>(n + 2), count_faces(*embedding));
+        ASSERT_EQ(true, graph_lib::is_polyhedral(prism));
+    }
+}
+
+TEST(planarity, many_components)
+{
+    // disjoint cubes, every search starts from its own root and reuses the same scratch
+    int const cubes = 1000;
+    std::vector<std::pair<int,int>> edges{};
+    for (int c = 0; c < cubes; ++c)
+    {
+        auto const b = 8 * c;
+        for (int i = 0; i < 4; ++i)
+        {
+            edges.emplace_back(b + i, b + (i + 1) % 4);
+            edges.emplace_back(b + 4 + i, b + 4 + (i + 1) % 4);
+            edges.emplace_back(b + i, b + 4 + i);
+        }
+    }
+    auto const g = make_graph(8 * cubes, edges);
+    auto const embedding = graph_lib::find_planar_embedding(g);
+
+    ASSERT_EQ(true, embedding.has_value());
+    ASSERT_EQ(static_cast<std::size_t>(6 * cubes), count_faces(*embedding));
+
+    // the last component isn't planar
+    auto const k5 = 8 * cubes;
+    for (int i = 0; i < 5; ++i)
+    {
+        for (int j = i + 1; j < 5; ++j)
+        {
+            edges.emplace_back(k5 + i, k5 + j);
+        }
+    }
+    ASSERT_EQ(false, graph_lib::is_planar(make_graph(8 * cubes + 5, edges)));
+}
+
+TEST(planarity, not_three_connected)
+{
+    // cycle
+    ASSERT_EQ(false, graph_lib::is_polyhedral(make_graph(5, {{0,1}, {1,2}, {2,3}, {3,4}, {4,0}})));
+
+    // two tetrahedra glued along the edge 0-1, {0,1} separates the graph
+    auto const glued = make_graph(6, {{0,1}, {0,2}, {0,3}, {1,2}, {1,3}, {2,3},
+                                      {0,4}, {0,5}, {1,4}, {1,5}, {4,5}});
+    ASSERT_EQ(true, graph_lib::is_planar(glued));
+    ASSERT_EQ(true, graph_lib::is_biconnected(glued));
+    ASSERT_EQ(false, graph_lib::is_polyhedral(glued));
+
+    // two tetrahedra sharing the vertex 0
+    auto const bowtie = make_graph(7, {{0,1}, {0,2}, {0,3}, {1,2}, {1,3}, {2,3},
+                                       {0,4}, {0,5}, {0,6}, {4,5}, {4,6}, {5,6}});
+    ASSERT_EQ(false, graph_lib::is_biconnected(bowtie));
+    ASSERT_EQ(false, graph_lib::is_polyhedral(bowtie));
+
+    // 3x3 grid, corners have degree 2
+    auto const grid = make_graph(9, {{0,1}, {1,2}, {3,4}, {4,5}, {6,7}, {7,8},
+                                     {0,3}, {3,6}, {1,4}, {4,7}, {2,5}, {5,8}});
+    ASSERT_EQ(true, graph_lib::is_planar(grid));
+    ASSERT_EQ(false, graph_lib::is_polyhedral(grid));
+
+    // disconnected
+    auto const prism = make_prism(5);
+    ASSERT_EQ(false, graph_lib::is_polyhedral(make_graph(8, {{0,1}, {0,2}, {0,3}, {1,2}, {1,3}, {2,3},
+                                                             {4,5}, {4,6}, {4,7}})));
+    ASSERT_EQ(true, graph_lib::is_polyhedral(prism));
+}
+
+TEST(planarity, polyhedron)
+{
+    graph_lib::graph<std::string> g{ std::vector
+                                                { std::pair{std::string{"A1"}, std::vector<std::string>{"A2","A5","B1","C1","C4"} },
+                                                  std::pair{std::string{"A2"}, std::vector<std::string>{"A1","A3","B1","B2","C3","C4"} },
+                                                  std::pair{std::string{"A3"}, std::vector<std::string>{"A2","A4","B2","B3","C2","C3"} },
+                                                  std::pair{std::string{"A4"}, std::vector<std::string>{"A3","A5","B3","B4","C1","C2"} },
+                                                  std::pair{std::string{"A5"}, std::vector<std::string>{"A1","A4","B1","B4","C1"} },
+                                                  std::pair{std::string{"B1"}, std::vector<std::string>{"A1","A2","A5","B2","B4","B5"} },
+                                                  std::pair{std::string{"B2"}, std::vector<std::string>{"A2","A3","B1","B3","B5"} },
+                                                  std::pair{std::string{"B3"}, std::vector<std::string>{"A3","A4","B2","B4","B5"} },
+                                                  std::pair{std::string{"B4"}, std::vector<std::string>{"A4","A5","B1","B3","B5"} },
+                                                  std::pair{std::string{"B5"}, std::vector<std::string>{"B1","B2","B3","B4"} },
+                                                  std::pair{std::string{"C1"}, std::vector<std::string>{"A1","A4","A5","C2","C3","C4"} },
+                                                  std::pair{std::string{"C2"}, std::vector<std::string>{"A3","A4","C1","C3"} },
+                                                  std::pair{std::string{"C3"}, std::vector<std::string>{"A2","A3","C1","C2","C4"} },
+                                                  std::pair{std::string{"C4"}, std::vector<std::string>{"A1","A2","C1","C3"} }
+                                                }
+                                   };
+
+    ASSERT_EQ(true, graph_lib::is_polyhedral(g));
+
+    g.remove_edge("A1", "A2");
+    g.remove_edge("A2", "B1");
+    g.remove_edge("A2", "C4");
+    ASSERT_EQ(true, graph_lib::is_planar(g));
+    ASSERT_EQ(true, graph_lib::is_polyhedral(g));
+
+    g.remove_edge("A2", "C3");
+    g.remove_edge("A2", "B2");
+    // A2 is left with a single neighbor
+    ASSERT_EQ(false, graph_lib::is_polyhedral(g));
+}
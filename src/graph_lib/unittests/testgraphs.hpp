@@ -0,0 +1,38 @@
+#pragma once
+
+// graphs shared by the tests of several features, every test header that uses them includes this one
+
+#include "graph.hpp"
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // triangulated grid of side x side vertices, every square is split by the diagonal
+    auto make_triangulated_grid(int side)
+        -> graph_lib::graph<int>
+    {
+        graph_lib::graph<int>::graph_vector_type adjacency{};
+        auto const connect = [&](int u, int v)
+        {
+            adjacency[static_cast<std::size_t>(u)].second.emplace_back(v);
+            adjacency[static_cast<std::size_t>(v)].second.emplace_back(u);
+        };
+
+        for (int v = 0; v < side * side; ++v)
+        {
+            adjacency.emplace_back(v, std::vector<int>{});
+        }
+        for (int row = 0; row < side; ++row)
+        {
+            for (int column = 0; column < side; ++column)
+            {
+                auto const v = row * side + column;
+                if (column + 1 < side) connect(v, v + 1);
+                if (row + 1 < side) connect(v, v + side);
+                if (column + 1 < side && row + 1 < side) connect(v, v + side + 1);
+            }
+        }
+        return graph_lib::graph<int>{std::move(adjacency)};
+    }
+}
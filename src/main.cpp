@@ -1,10 +1,375 @@
 //Main file
 
+/*
+    Batch driver for the library, runs the whole pipeline on one input file:
+
+    load -> validate -> triangular faces -> cone triangulation at the apex q -> output
+
+    Faces, cone and output run at the same time on their own threads, connected by the bounded queues
+    of batches, so the triples are written while they are still being found and the memory used
+    by the results stays bounded by the capacity of the queues.
+    At the end the report with the time and the peak memory of every stage is printed to stderr.
+
+    usage: Master [options] <input>
+        --format off|edges       format of the input, by default .off files are meshes and the rest are edge lists
+        --pipeline faces|cone    write the triangular faces or the tetrahedra of the cone (default)
+        --apex q                 apex of the cone, by default the first vertex of the graph
+        --output path            file to write the result to, by default stdout
+        --queue n                capacity of every queue in batches (default 16)
+        --batch n                number of items in the batch (default 4096)
+        --no-validate            trust the input and skip the validation
+*/
+
 #include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <optional>
+#include <sys/resource.h>
 #include "graph.hpp"
+#include "graph_algorithms.hpp"
+#include "graph_io.hpp"
+#include "bounded_queue.hpp"
+
+namespace
+{
+    using vertex_type = int;
+    using graph_type  = graph_lib::graph<vertex_type>;
+    using face_type   = std::tuple<vertex_type, vertex_type, vertex_type>;
+    using tetra_type  = std::tuple<vertex_type, vertex_type, vertex_type, vertex_type>;
+    using clock_type  = std::chrono::steady_clock;
+
+    struct options
+    {
+        std::string                input;
+        std::string                format;
+        std::string                pipeline{"cone"};
+        std::optional<vertex_type> apex;
+        std::string                output;
+        std::size_t                queue{16};
+        std::size_t                batch{4096};
+        bool                       validate{true};
+    };
+
+    // work is the time the stage was busy, wait is the time it was blocked on the queues
+    // wall is measured from the start of the pipeline to the end of the stage
+    struct stage_report
+    {
+        std::string name;
+        std::size_t items;
+        double      work;
+        double      wait;
+        double      wall;
+        long        peak_rss_kib;
+    };
+
+    [[nodiscard]] auto seconds(clock_type::duration duration)
+        -> double
+    {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    // peak resident memory of the whole process so far
+    [[nodiscard]] auto peak_rss_kib()
+        -> long
+    {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+    void print_usage()
+    {
+        std::cerr << "usage: Master [--format off|edges] [--pipeline faces|cone] [--apex q] [--output path]\n"
+                     "              [--queue n] [--batch n] [--no-validate] <input>\n";
+    }
+
+    [[nodiscard]] auto parse_options(int argc, char * argv[])
+        -> std::optional<options>
+    {
+        options parsed{};
+        std::vector<std::string> const arguments(argv + 1, argv + argc);
+
+        for (std::size_t i = 0; i < arguments.size(); ++i)
+        {
+            auto const & argument = arguments[i];
+            auto const has_value  = i + 1 < arguments.size();
+
+            try
+            {
+                if (argument == "--no-validate")
+                {
+                    parsed.validate = false;
+                }
+                else if (argument == "--format" && has_value)
+                {
+                    parsed.format = arguments[++i];
+                }
+                else if (argument == "--pipeline" && has_value)
+                {
+                    parsed.pipeline = arguments[++i];
+                }
+                else if (argument == "--apex" && has_value)
+                {
+                    parsed.apex = std::stoi(arguments[++i]);
+                }
+                else if (argument == "--output" && has_value)
+                {
+                    parsed.output = arguments[++i];
+                }
+                else if (argument == "--queue" && has_value)
+                {
+                    parsed.queue = std::stoul(arguments[++i]);
+                }
+                else if (argument == "--batch" && has_value)
+                {
+                    parsed.batch = std::stoul(arguments[++i]);
+                }
+                else if (parsed.input.empty() && argument.rfind("--", 0) != 0)
+                {
+                    parsed.input = argument;
+                }
+                else
+                {
+                    return std::nullopt;
+                }
+            }
+            catch (std::exception const &)
+            {
+                return std::nullopt;
+            }
+        }
+
+        if (parsed.format.empty())
+        {
+            auto const extension = parsed.input.size() >= 4 ? parsed.input.substr(parsed.input.size() - 4) : "";
+            parsed.format = (extension == ".off" || extension == ".OFF") ? "off" : "edges";
+        }
+
+        bool const valid = !parsed.input.empty() && parsed.queue > 0 && parsed.batch > 0
+                           && (parsed.format == "off" || parsed.format == "edges")
+                           && (parsed.pipeline == "faces" || parsed.pipeline == "cone");
+
+        return valid ? std::optional{parsed} : std::nullopt;
+    }
+
+    // output stage, writes every item of every batch on its own line
+    template <typename T>
+    auto write_items(graph_lib::bounded_queue<std::vector<T>> & queue, graph_lib::output_buffer & output)
+        -> std::size_t
+    {
+        std::size_t items{};
+        while (auto batch = queue.pop())
+        {
+            if constexpr (std::tuple_size_v<T> == 3)
+            {
+                graph_lib::write_triangles(output, *batch);
+            }
+            else
+            {
+                graph_lib::write_tetrahedra(output, *batch);
+            }
+            items += batch->size();
+        }
+        return items;
+    }
+
+    void print_report(std::vector<stage_report> const & reports)
+    {
+        std::cerr << std::left << std::setw(10) << "stage" << std::right
+                  << std::setw(14) << "items"
+                  << std::setw(12) << "work [s]"
+                  << std::setw(12) << "wait [s]"
+                  << std::setw(12) << "wall [s]"
+                  << std::setw(18) << "peak rss [MiB]" << '\n';
+
+        std::cerr << std::fixed << std::setprecision(3);
+        for (auto const & report : reports)
+        {
+            std::cerr << std::left << std::setw(10) << report.name << std::right
+                      << std::setw(14) << report.items
+                      << std::setw(12) << report.work
+                      << std::setw(12) << report.wait
+                      << std::setw(12) << report.wall
+                      << std::setw(18) << static_cast<double>(report.peak_rss_kib) / 1024.0 << '\n';
+        }
+    }
+}
 
-int main([[maybe_unused]]int argc, [[maybe_unused]] char* argv[])
+int main(int argc, char* argv[])
 {
-    graph_lib::graph<int, false> g{};
+    auto const parsed = parse_options(argc, argv);
+    if (!parsed)
+    {
+        print_usage();
+        return 2;
+    }
+    auto const & opts = *parsed;
+
+    std::vector<stage_report> reports{};
+    auto const start = clock_type::now();
+
+    // load
+    std::ifstream input{opts.input};
+    if (!input)
+    {
+        std::cerr << "Master: can't open " << opts.input << '\n';
+        return 1;
+    }
+
+    auto adjacency_list = opts.format == "off" ? graph_lib::read_off<vertex_type>(input)
+                                               : graph_lib::read_edge_list<vertex_type>(input);
+    if (!adjacency_list)
+    {
+        std::cerr << "Master: malformed input " << opts.input << '\n';
+        return 1;
+    }
+    auto const loaded = clock_type::now();
+    reports.emplace_back(stage_report{"load", adjacency_list->size(), seconds(loaded - start), 0.0,
+                                      seconds(loaded - start), peak_rss_kib()});
+
+    // validate
+    graph_type g{};
+    if (opts.validate)
+    {
+        graph_lib::validation_report<vertex_type> validation{};
+        g = graph_type{std::move(*adjacency_list), validation};
+
+        if (!validation.valid())
+        {
+            std::cerr << "Master: input isn't a valid graph, " << validation.violations.size() << " violations, first:"
+                      << " vertex " << validation.violations.front().vertex
+                      << " neighbor " << validation.violations.front().neighbor << '\n';
+            return 1;
+        }
+    }
+    else
+    {
+        g = graph_type{std::move(*adjacency_list)};
+    }
+    auto const validated = clock_type::now();
+    reports.emplace_back(stage_report{"validate", g.num_vertices(), seconds(validated - loaded), 0.0,
+                                      seconds(validated - start), peak_rss_kib()});
+
+    if (g.num_vertices() == 0)
+    {
+        std::cerr << "Master: the graph is empty\n";
+        return 1;
+    }
+
+    auto const apex = opts.apex.value_or(g.cbegin()->first);
+    if (opts.pipeline == "cone" && g.vertex_index().count(apex) == 0)
+    {
+        std::cerr << "Master: apex " << apex << " isn't a vertex of the graph\n";
+        return 1;
+    }
+
+    std::ofstream file{};
+    if (!opts.output.empty())
+    {
+        file.open(opts.output);
+        if (!file)
+        {
+            std::cerr << "Master: can't open " << opts.output << '\n';
+            return 1;
+        }
+    }
+    graph_lib::output_buffer output{opts.output.empty() ? std::cout : file};
+
+    graph_lib::bounded_queue<std::vector<face_type>>  faces{opts.queue};
+    graph_lib::bounded_queue<std::vector<tetra_type>> tetrahedra{opts.queue};
+
+    // faces
+    stage_report faces_report{"faces", 0, 0.0, 0.0, 0.0, 0};
+    std::thread faces_stage{[&]
+    {
+        auto const begin = clock_type::now();
+        std::vector<face_type> batch{};
+        batch.reserve(opts.batch);
+
+        graph_lib::for_each_triangular_face(g, [&](auto const & u, auto const & v, auto const & w)
+        {
+            batch.emplace_back(u, v, w);
+            if (batch.size() == opts.batch)
+            {
+                faces_report.items += batch.size();
+                faces.push(std::move(batch));
+                batch = std::vector<face_type>{};
+                batch.reserve(opts.batch);
+            }
+        });
+        if (!batch.empty())
+        {
+            faces_report.items += batch.size();
+            faces.push(std::move(batch));
+        }
+        faces.close();
+
+        auto const end = clock_type::now();
+        faces_report.wait = seconds(faces.push_waited());
+        faces_report.work = seconds(end - begin) - faces_report.wait;
+        faces_report.wall = seconds(end - start);
+        faces_report.peak_rss_kib = peak_rss_kib();
+    }};
+
+    // cone
+    stage_report cone_report{"cone", 0, 0.0, 0.0, 0.0, 0};
+    std::thread cone_stage{};
+    if (opts.pipeline == "cone")
+    {
+        cone_stage = std::thread{[&]
+        {
+            auto const begin = clock_type::now();
+            while (auto batch = faces.pop())
+            {
+                auto tetra = graph_lib::cone_triangulation(*batch, apex);
+                cone_report.items += tetra.size();
+                if (!tetrahedra.push(std::move(tetra)))
+                {
+                    faces.close();
+                }
+            }
+            tetrahedra.close();
+
+            auto const end = clock_type::now();
+            cone_report.wait = seconds(faces.pop_waited() + tetrahedra.push_waited());
+            cone_report.work = seconds(end - begin) - cone_report.wait;
+            cone_report.wall = seconds(end - start);
+            cone_report.peak_rss_kib = peak_rss_kib();
+        }};
+    }
+
+    // output
+    auto const begin = clock_type::now();
+    auto const written = opts.pipeline == "cone" ? write_items(tetrahedra, output) : write_items(faces, output);
+    auto const flushed = output.flush();
+    auto const end = clock_type::now();
+
+    faces_stage.join();
+    if (cone_stage.joinable())
+    {
+        cone_stage.join();
+    }
+
+    auto const output_wait = opts.pipeline == "cone" ? tetrahedra.pop_waited() : faces.pop_waited();
+    reports.emplace_back(faces_report);
+    if (opts.pipeline == "cone")
+    {
+        reports.emplace_back(cone_report);
+    }
+    reports.emplace_back(stage_report{"output", written, seconds(end - begin - output_wait), seconds(output_wait),
+                                      seconds(end - start), peak_rss_kib()});
+
+    print_report(reports);
+
+    if (!flushed)
+    {
+        std::cerr << "Master: writing the output failed\n";
+        return 1;
+    }
     return 0;
-}
\ No newline at end of file
+}